@@ -4,6 +4,8 @@
 #include "../utils/general.hpp"
 
 #include <matjson.hpp>
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
 #include <string_view>
 #include <tulip/TulipHook.hpp>
@@ -213,3 +215,55 @@ namespace geode {
         [[nodiscard]] matjson::Value getRuntimeInfo() const;
     };
 }
+
+namespace geode::geode_internal {
+    /**
+     * Call statistics for a single hook detour, collected when the game is 
+     * launched with the `--geode:profile-hooks` flag
+     */
+    struct HookProfileSlot {
+        std::atomic<uint64_t> calls = 0;
+        std::atomic<uint64_t> sampledCalls = 0;
+        std::atomic<uint64_t> sampledNanoseconds = 0;
+    };
+
+    /**
+     * Get the profile slot for the given detour, or null if hook profiling 
+     * is disabled. Slots live for the whole runtime of the game
+     */
+    GEODE_DLL HookProfileSlot* getHookProfileSlot(void* detour);
+
+    /**
+     * Counts a call to a hook detour and measures how long it took. Only 
+     * every 16th call is timed so the overhead stays low enough to leave 
+     * profiling on during normal play
+     */
+    class HookProfileScope final {
+        using Clock = std::chrono::steady_clock;
+
+        HookProfileSlot* m_slot;
+        Clock::time_point m_start;
+
+    public:
+        static constexpr uint64_t SAMPLE_INTERVAL = 16;
+
+        explicit HookProfileScope(HookProfileSlot* slot) : m_slot(slot) {
+            if (!m_slot) return;
+            if (m_slot->calls.fetch_add(1, std::memory_order_relaxed) % SAMPLE_INTERVAL == 0) {
+                m_start = Clock::now();
+            }
+            else {
+                m_slot = nullptr;
+            }
+        }
+        ~HookProfileScope() {
+            if (!m_slot) return;
+            auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start);
+            m_slot->sampledCalls.fetch_add(1, std::memory_order_relaxed);
+            m_slot->sampledNanoseconds.fetch_add(time.count(), std::memory_order_relaxed);
+        }
+
+        HookProfileScope(HookProfileScope const&) = delete;
+        HookProfileScope& operator=(HookProfileScope const&) = delete;
+    };
+}
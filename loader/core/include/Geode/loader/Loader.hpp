@@ -42,6 +42,7 @@ namespace geode {
             DisabledDependency,
             OutdatedDependency,
             OutdatedIncompatibility,
+            DependencyCycle,
         };
         Type type;
         std::variant<std::filesystem::path, ModMetadata, Mod*> cause;
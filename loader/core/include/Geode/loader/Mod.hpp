@@ -9,6 +9,7 @@
 #include "Hook.hpp"
 #include "ModMetadata.hpp"
 #include "Setting.hpp"
+#include "ModSettingsManager.hpp"
 #include "Types.hpp"
 #include "Loader.hpp"
 
@@ -55,6 +56,9 @@ namespace geode {
 
     class ModImpl;
 
+    template <class T>
+    class SettingHandle;
+
     /**
      * Represents a Mod ingame.
      * @class Mod
@@ -77,6 +81,11 @@ namespace geode {
 
         friend void GEODE_CALL ::geode_implicit_load(Mod*);
 
+        // Get the container for the mod's saved values to change them through
+        // the functions below. Unlike getSaveContainer, this doesn't make
+        // every following save check the values for changes
+        matjson::Value& getSaveContainerForWrite();
+
     public:
         // no copying
         Mod(Mod const&) = delete;
@@ -224,7 +233,16 @@ namespace geode {
             return Loader::get()->parseLaunchArgument<T>(this->getLaunchArgumentName(name));
         }
 
+        /**
+         * Get the container for the mod's saved values. Changes made through
+         * the returned reference are written on the next save, even if the
+         * reference is kept and the values are changed later on
+         */
         matjson::Value& getSaveContainer();
+        /**
+         * Get the container for the mod's saved values for reading
+         */
+        matjson::Value const& getSaveContainer() const;
         matjson::Value& getSavedSettingsData();
 
         /**
@@ -242,6 +260,16 @@ namespace geode {
             return T();
         }
 
+        /**
+         * Get a handle to a setting that caches the lookup and type check, 
+         * for reading the setting's value in hot code (e.g. every frame). 
+         * Reading through the handle is equivalent to calling 
+         * `getSettingValue` with the same key, but without the cost of 
+         * finding the setting every time
+         */
+        template <class T>
+        SettingHandle<T> getSettingHandle(std::string_view key);
+
         template <class T>
         T setSettingValue(std::string_view key, T const& value) {
             using S = typename SettingTypeForValueType<T>::SettingType;
@@ -257,7 +285,7 @@ namespace geode {
 
         template <class T>
         T getSavedValue(std::string_view key) {
-            auto& saved = this->getSaveContainer();
+            auto& saved = std::as_const(*this).getSaveContainer();
             if (auto res = saved.get(key).andThen([](auto&& v) {
                 return v.template as<T>();
             }); res.isOk()) {
@@ -268,13 +296,13 @@ namespace geode {
 
         template <class T>
         T getSavedValue(std::string_view key, T const& defaultValue) {
-            auto& saved = this->getSaveContainer();
+            auto& saved = std::as_const(*this).getSaveContainer();
             if (auto res = saved.get(key).andThen([](auto&& v) {
                 return v.template as<T>();
             }); res.isOk()) {
                 return res.unwrap();
             }
-            saved[key] = matjson::Value(defaultValue);
+            this->getSaveContainerForWrite()[key] = matjson::Value(defaultValue);
             return defaultValue;
         }
 
@@ -287,7 +315,7 @@ namespace geode {
          */
         template <class T>
         T setSavedValue(std::string_view key, T const& value) {
-            auto& saved = this->getSaveContainer();
+            auto& saved = this->getSaveContainerForWrite();
             auto old = this->getSavedValue<T>(key);
             saved[key] = value;
             return old;
@@ -376,6 +404,17 @@ namespace geode {
             return Ok(ptr);
         }
 
+        /**
+         * Write many patches at once. Every patch is checked for overlaps 
+         * before anything is written, and patches next to each other in 
+         * memory are written together, so this is much faster than calling 
+         * patch() in a loop
+         * @param patches Pairs of addresses and the data to write there
+         * @returns The created patches in the same order, or an error if 
+         * any of them couldn't be applied, in which case none of them are
+         */
+        Result<std::vector<Patch*>> patchAll(std::vector<std::pair<void*, ByteVector>> const& patches);
+
         /**
          * Claims an existing patch object, marking this mod as its owner.
          * If the patch has "auto enable" set, this will enable the patch.
@@ -475,6 +514,71 @@ namespace geode {
 
         friend class ModImpl;
     };
+
+    /**
+     * A handle to a mod's setting of a specific type. The setting is looked 
+     * up and type checked once, after which reading its value is a plain 
+     * member access. If the mod's settings are recreated, the handle looks 
+     * the setting up again on its next read
+     */
+    template <class T>
+    class SettingHandle final {
+    public:
+        using SettingType = typename SettingTypeForValueType<T>::SettingType;
+
+    private:
+        Mod* m_mod = nullptr;
+        std::string m_key;
+        mutable std::shared_ptr<SettingType> m_setting = nullptr;
+        mutable size_t m_generation = 0;
+
+        void resolve() const {
+            m_generation = ModSettingsManager::getSettingsGeneration().load(std::memory_order_acquire);
+            m_setting = m_mod ? cast::typeinfo_pointer_cast<SettingType>(m_mod->getSetting(m_key)) : nullptr;
+        }
+
+    public:
+        SettingHandle() = default;
+        SettingHandle(Mod* mod, std::string_view key) : m_mod(mod), m_key(key) {
+            this->resolve();
+        }
+
+        /**
+         * Get the current value of the setting, or a default-constructed 
+         * value if the setting doesn't exist or is of a different type
+         */
+        T get() const {
+            if (m_generation != ModSettingsManager::getSettingsGeneration().load(std::memory_order_acquire)) {
+                this->resolve();
+            }
+            if (m_setting) {
+                return m_setting->getValue();
+            }
+            return T();
+        }
+        T operator*() const {
+            return this->get();
+        }
+
+        /**
+         * Get the setting this handle points to, or null if it doesn't exist
+         */
+        std::shared_ptr<SettingType> getSetting() const {
+            this->get();
+            return m_setting;
+        }
+        std::string_view getKey() const {
+            return m_key;
+        }
+        Mod* getMod() const {
+            return m_mod;
+        }
+    };
+
+    template <class T>
+    SettingHandle<T> Mod::getSettingHandle(std::string_view key) {
+        return SettingHandle<T>(this, key);
+    }
 }
 
 namespace geode::geode_internal {
@@ -2,6 +2,7 @@
 
 #include "../core/Prelude.hpp"
 #include "Setting.hpp"
+#include <atomic>
 
 namespace geode {
     class Mod;
@@ -20,6 +21,13 @@ namespace geode {
     public:
         static ModSettingsManager* from(Mod* mod);
 
+        /**
+         * A counter that is bumped whenever the setting objects of any mod are 
+         * created or replaced. Used by `SettingHandle` to know when its cached 
+         * setting needs to be looked up again
+         */
+        static std::atomic_size_t const& getSettingsGeneration();
+
         ModSettingsManager(ModMetadata const& metadata);
         ~ModSettingsManager();
 
@@ -2,13 +2,25 @@
 
 #include "Event.hpp"
 #include <matjson.hpp>
+#include <cstdint>
+#include <functional>
+#include <span>
 
 namespace geode::ipc {
     #ifdef GEODE_IS_WINDOWS
     constexpr char const* IPC_PIPE_NAME = R"(\\.\pipe\GeodeIPCPipe)";
     #endif
 
+    #ifdef GEODE_IS_ANDROID
+    // Name of the socket in the abstract namespace, which can be reached from
+    // a computer with `adb forward tcp:<port> localabstract:GeodeIPCPipe`
+    constexpr char const* IPC_SOCKET_NAME = "GeodeIPCPipe";
+    #endif
+
     #ifdef GEODE_IS_MACOS
+    constexpr char const* IPC_SOCKET_PATH = "/tmp/GeodeIPCPipe.sock";
+    // The mach port IPC used to be served over; nothing listens on it anymore
+    [[deprecated("IPC is served over the Unix socket at IPC_SOCKET_PATH now")]]
     constexpr char const* IPC_PORT_NAME = "GeodeIPCPipe";
     #endif
 
@@ -22,6 +34,21 @@ namespace geode::ipc {
     // messages the get by using the reply method on the event provided. For
     // example, an external application can query what mods are loaded in Geode
     // by sending the `list-mods` message to `geode.loader`.
+    //
+    // On Windows, a message is written to the pipe as JSON and the reply is
+    // read back before the pipe is closed. On Android and macOS, the Unix
+    // socket takes any number of messages, each framed as its size in bytes
+    // (a 32-bit little endian integer) followed by its JSON. Every message
+    // may have an `id`, which is sent back in its reply as
+    // `{ "id": ..., "reply": ... }` (or `"error"` if it couldn't be handled),
+    // so many messages can be in flight at once. Messages are always handled
+    // on the main thread.
+    //
+    // Socket messages can also carry binary data, so things like level data
+    // or screenshots don't have to go through base64 and JSON. Such a frame
+    // has the highest bit of its size set, and its payload starts with the
+    // attachment's size (a 32-bit little endian integer), followed by the
+    // attachment and then the JSON. Replies carry attachments the same way.
 
     class GEODE_DLL IPCEvent final : public Event {
     protected:
@@ -34,6 +61,12 @@ namespace geode::ipc {
         std::unique_ptr<matjson::Value> messageData;
         matjson::Value& replyData;
 
+    protected:
+        std::span<uint8_t const> m_attachment;
+        std::function<std::span<uint8_t>(size_t)> m_replyAttachmentWriter;
+
+    public:
+
         friend class IPCFilter;
 
         IPCEvent(
@@ -43,7 +76,39 @@ namespace geode::ipc {
             matjson::Value const& messageData,
             matjson::Value& replyData
         );
+        /**
+         * @param attachment Binary data sent with the message. Not copied,
+         * so it must outlive the event
+         * @param replyAttachmentWriter Reserves space for a binary reply in
+         * the transport's buffer, or null if the transport can't send one
+         */
+        IPCEvent(
+            void* rawPipeHandle,
+            std::string const& targetModID,
+            std::string const& messageID,
+            matjson::Value&& messageData,
+            std::span<uint8_t const> attachment,
+            std::function<std::span<uint8_t>(size_t)> replyAttachmentWriter,
+            matjson::Value& replyData
+        );
         virtual ~IPCEvent();
+
+        /**
+         * Get the binary data sent with the message, if any. This points
+         * directly into the buffer the message was received into, so it's
+         * only valid until the listener returns
+         */
+        std::span<uint8_t const> getAttachment() const;
+        /**
+         * Reserve space for binary data to send back with the reply. The
+         * data is written directly into the buffer the reply is sent from
+         * @param size Size of the attachment in bytes
+         * @returns Where to write the attachment, which is only valid until
+         * the listener returns. Empty if the message was sent through a
+         * transport without attachments (the Windows pipe), or if space for
+         * an attachment has already been reserved
+         */
+        std::span<uint8_t> writeReplyAttachment(size_t size);
     };
 
     class GEODE_DLL IPCFilter final : public EventFilter<IPCEvent> {
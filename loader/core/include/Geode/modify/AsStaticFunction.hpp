@@ -2,10 +2,12 @@
 #include "../utils/addresser.hpp"
 #include "Traits.hpp"
 #include "../loader/Log.hpp"
+#include "../loader/Hook.hpp"
 
 namespace geode::modifier {
 /**
  * A helper struct that generates a static function that calls the given function.
+ * The function is counted and timed when hook profiling is enabled.
  */
 #define GEODE_AS_STATIC_FUNCTION(FunctionName_)                                                   \
     template <class Class2, class FunctionType>                                                   \
@@ -15,12 +17,20 @@ namespace geode::modifier {
         template <class Return, class... Params>                                                  \
         struct Impl<Return (*)(Params...)> {                                                      \
             static Return GEODE_CDECL_CALL function(Params... params) {                           \
+                static auto profileSlot = geode::geode_internal::getHookProfileSlot(              \
+                    reinterpret_cast<void*>(&function)                                            \
+                );                                                                                \
+                geode::geode_internal::HookProfileScope profileScope(profileSlot);                \
                 return Class2::FunctionName_(params...);                                          \
             }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...)> {                                               \
             static Return GEODE_CDECL_CALL function(Class* self, Params... params) {              \
+                static auto profileSlot = geode::geode_internal::getHookProfileSlot(              \
+                    reinterpret_cast<void*>(&function)                                            \
+                );                                                                                \
+                geode::geode_internal::HookProfileScope profileScope(profileSlot);                \
                 auto self2 = addresser::rthunkAdjust(                                             \
                     Resolve<Params...>::func(&Class2::FunctionName_), self                        \
                 );                                                                                \
@@ -30,6 +40,10 @@ namespace geode::modifier {
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...) const> {                                         \
             static Return GEODE_CDECL_CALL function(Class const* self, Params... params) {        \
+                static auto profileSlot = geode::geode_internal::getHookProfileSlot(              \
+                    reinterpret_cast<void*>(&function)                                            \
+                );                                                                                \
+                geode::geode_internal::HookProfileScope profileScope(profileSlot);                \
                 auto self2 = addresser::rthunkAdjust(                                             \
                     Resolve<Params...>::func(&Class2::FunctionName_), self                        \
                 );                                                                                \
@@ -9,12 +9,41 @@
 
 namespace geode {
     struct TaskVoid {};
+
+    /**
+     * Where the mapper of a `Task::mapOn` stage is executed
+     */
+    enum class TaskExecutor {
+        /// Run the mapper on the main thread when the mapped Task finishes
+        MainThread,
+        /// Run the mapper on a separate worker thread; only the mapped 
+        /// result is delivered to the main thread
+        Worker,
+    };
+
     namespace geode_internal {
         template <class T, class P>
         struct TaskPromiseBase;
 
         template <class T, class P>
         struct TaskAwaiter;
+
+        /**
+         * Schedules the delivery of a Task event on the main thread. If 
+         * `samePass` is true and this is called while another Task event is 
+         * being delivered, the new event is delivered right after it in the 
+         * same main thread queue pass instead of the next one, so results 
+         * propagate through chains of mapped Tasks without waiting a frame 
+         * per step. Events are delivered in the order they were scheduled in
+         */
+        GEODE_DLL void scheduleTaskEvent(ScheduledFunction&& deliver, bool samePass);
+
+        /**
+         * Runs a job on the shared pool of Task worker threads. The pool has 
+         * a fixed number of threads, so jobs wait for a free one when they 
+         * are all busy
+         */
+        GEODE_DLL void runTaskWorker(std::function<void()>&& job);
     }
 
     template <typename T>
@@ -160,6 +189,8 @@ namespace geode {
             bool m_finalEventPosted = false;
             std::string m_name;
             std::unique_ptr<ExtraData> m_extraData = nullptr;
+            // Number of events scheduled for delivery but not yet delivered
+            size_t m_scheduledEvents = 0;
 
             class PrivateMarker final {};
 
@@ -291,13 +322,28 @@ namespace geode {
 
         Task(std::shared_ptr<Handle> handle) : m_handle(handle) {}
 
+        // Schedules the delivery of one of this Task's events. Must be called 
+        // with the Handle's mutex locked
+        static void schedule(std::shared_ptr<Handle> const& handle, ScheduledFunction&& deliver) {
+            // Only deliver in the current pass if none of this Task's earlier 
+            // events are still waiting, so that a Task's own events can never 
+            // be reordered
+            bool samePass = handle->m_scheduledEvents == 0;
+            handle->m_scheduledEvents += 1;
+            geode_internal::scheduleTaskEvent([handle, deliver = std::move(deliver)]() {
+                deliver();
+                std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
+                handle->m_scheduledEvents -= 1;
+            }, samePass);
+        }
+
         static void finish(std::shared_ptr<Handle> handle, Type&& value) {
             if (!handle) return;
             std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
             if (handle->m_status == Status::Pending) {
                 handle->m_status = Status::Finished;
                 handle->m_resultValue.emplace(std::move(value));
-                queueInMainThread([handle, value = &*handle->m_resultValue]() mutable {
+                Task::schedule(handle, [handle, value = &*handle->m_resultValue]() mutable {
                     // SAFETY: Task::all() depends on the lifetime of the value pointer
                     // being as long as the lifetime of the task itself
                     Event::createFinished(handle, value).post();
@@ -310,7 +356,7 @@ namespace geode {
             if (!handle) return;
             std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
             if (handle->m_status == Status::Pending) {
-                queueInMainThread([handle, value = std::move(value)]() mutable {
+                Task::schedule(handle, [handle, value = std::move(value)]() mutable {
                     Event::createProgressed(handle, &value).post();
                 });
             }
@@ -325,7 +371,7 @@ namespace geode {
                 if (!shallow && handle->m_extraData) {
                     handle->m_extraData->cancel();
                 }
-                queueInMainThread([handle]() mutable {
+                Task::schedule(handle, [handle]() mutable {
                     Event::createCancelled(handle).post();
                     std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
                     handle->m_finalEventPosted = true;
@@ -333,6 +379,40 @@ namespace geode {
             }
         }
 
+        // Runs the result mapper of a `mapOn` stage on the given executor and 
+        // finishes the mapped Task with its output. `parent` is held onto so 
+        // the value being mapped stays alive for as long as the mapper needs it
+        template <is_task_type T2, std::move_constructible P2, class ResultMapper>
+        static void finishMapped(
+            TaskExecutor executor,
+            std::weak_ptr<typename Task<T2, P2>::Handle> handle,
+            std::shared_ptr<Handle> parent,
+            ResultMapper&& resultMapper
+        ) {
+            if (executor == TaskExecutor::MainThread) {
+                Task<T2, P2>::finish(handle.lock(), std::move(resultMapper(&*parent->m_resultValue)));
+                return;
+            }
+            geode_internal::runTaskWorker([handle = std::move(handle), parent = std::move(parent), resultMapper = std::move(resultMapper)]() mutable {
+                // The worker may end up holding the last reference to either 
+                // Task, and destroying one destroys its listeners, so they're 
+                // always released on the main thread
+                auto release = [](std::shared_ptr<typename Task<T2, P2>::Handle> task, std::shared_ptr<Handle> parent) {
+                    queueInMainThread([task = std::move(task), parent = std::move(parent)]() {});
+                };
+                auto task = handle.lock();
+                if (task && task->is(Task<T2, P2>::Status::Pending)) {
+                    // Don't hold onto the mapped Task while the mapper runs, 
+                    // so it can still be cancelled by dropping its listeners
+                    release(std::move(task), nullptr);
+                    auto value = resultMapper(&*parent->m_resultValue);
+                    task = handle.lock();
+                    Task<T2, P2>::finish(task, std::move(value));
+                }
+                release(std::move(task), std::move(parent));
+            });
+        }
+
         template <is_task_type T2, std::move_constructible P2>
         friend class Task;
 
@@ -646,13 +726,18 @@ namespace geode {
 
         /**
          * Create a new Task that listens to this Task and maps the values using 
-         * the provided functions. 
+         * the provided functions, running the result mapper on the given 
+         * executor. Use `TaskExecutor::Worker` for CPU-heavy mappers (like 
+         * parsing a large response) so they don't block the main thread; 
+         * progress mapping and cancellation always happen on the main thread.
          * The new Task takes (shared) ownership of this Task, so the new Task 
          * may very well be its only listener
+         * @param executor Where the result mapper is executed
          * @param resultMapper Function that converts the finished values of 
          * the mapped Task to a desired type. Note that the function is only 
          * given a pointer to the finish value, as `T` is not guaranteed to be 
-         * copyable - the mapper may NOT move out of the value!
+         * copyable - the mapper may NOT move out of the value! If running on 
+         * a worker, the mapper must not touch any main-thread-only state
          * @param progressMapper Function that converts the progress values of 
          * the mapped Task to a desired type
          * @param onCancelled Function that is called if the mapped Task is 
@@ -661,7 +746,7 @@ namespace geode {
          * the mapped task is appended to the end
          */
         template <class ResultMapper, class ProgressMapper, class OnCancelled>
-        auto map(ResultMapper&& resultMapper, ProgressMapper&& progressMapper, OnCancelled&& onCancelled, std::string_view name = "<Mapping Task>") const {
+        auto mapOn(TaskExecutor executor, ResultMapper&& resultMapper, ProgressMapper&& progressMapper, OnCancelled&& onCancelled, std::string_view name = "<Mapping Task>") const {
             using T2 = decltype(resultMapper(std::declval<Type*>()));
             using P2 = decltype(progressMapper(std::declval<P*>()));
 
@@ -680,20 +765,23 @@ namespace geode {
             }
             // If the current task is finished, immediately map the value and post that
             else if (m_handle->m_status == Status::Finished) {
-                Task<T2, P2>::finish(task.m_handle, std::move(resultMapper(&*m_handle->m_resultValue)));
+                Task::finishMapped<T2, P2>(executor, task.m_handle, m_handle, std::move(resultMapper));
             }
             // Otherwise start listening and waiting for the current task to finish
             else {
                 task.m_handle->m_extraData = std::make_unique<typename Task<T2, P2>::Handle::ExtraData>(
                     static_cast<void*>(new EventListener<Task>(
                         [
+                            executor,
                             handle = std::weak_ptr(task.m_handle),
                             resultMapper = std::move(resultMapper),
                             progressMapper = std::move(progressMapper),
                             onCancelled = std::move(onCancelled)
                         ](Event* event) mutable {
-                            if (auto v = event->getValue()) {
-                                Task<T2, P2>::finish(handle.lock(), std::move(resultMapper(v)));
+                            if (event->getValue()) {
+                                // The finish event is only posted once, so 
+                                // the mapper may be moved out here
+                                Task::finishMapped<T2, P2>(executor, handle, event->m_handle, std::move(resultMapper));
                             }
                             else if (auto p = event->getProgress()) {
                                 Task<T2, P2>::progress(handle.lock(), std::move(progressMapper(p)));
@@ -717,6 +805,63 @@ namespace geode {
             return task;
         }
 
+        /**
+         * Create a new Task that listens to this Task and maps the values using 
+         * the provided functions, running the result mapper on the given 
+         * executor. See the other overload of `mapOn` for details
+         * @param executor Where the result mapper is executed
+         * @param resultMapper Function that converts the finished values of 
+         * the mapped Task to a desired type. The mapper may NOT move out of 
+         * the value!
+         * @param progressMapper Function that converts the progress values of 
+         * the mapped Task to a desired type
+         * @param name The name of the Task; used for debugging. The name of 
+         * the mapped task is appended to the end
+         */
+        template <class ResultMapper, class ProgressMapper>
+        auto mapOn(TaskExecutor executor, ResultMapper&& resultMapper, ProgressMapper&& progressMapper, std::string_view name = "<Mapping Task>") const {
+            return this->mapOn(executor, std::move(resultMapper), std::move(progressMapper), +[]() {}, name);
+        }
+
+        /**
+         * Create a new Task that listens to this Task and maps the finish value 
+         * using the provided function, running it on the given executor. 
+         * Progress is mapped by copy-constructing the value as-is. See the 
+         * other overloads of `mapOn` for details
+         * @param executor Where the result mapper is executed
+         * @param resultMapper Function that converts the finished values of 
+         * the mapped Task to a desired type. The mapper may NOT move out of 
+         * the value!
+         * @param name The name of the Task; used for debugging. The name of 
+         * the mapped task is appended to the end
+         */
+        template <class ResultMapper>
+            requires std::copy_constructible<P>
+        auto mapOn(TaskExecutor executor, ResultMapper&& resultMapper, std::string_view name = "<Mapping Task>") const {
+            return this->mapOn(executor, std::move(resultMapper), +[](P* p) -> P { return *p; }, name);
+        }
+
+        /**
+         * Create a new Task that listens to this Task and maps the values using 
+         * the provided functions. The mappers are run on the main thread.
+         * The new Task takes (shared) ownership of this Task, so the new Task 
+         * may very well be its only listener
+         * @param resultMapper Function that converts the finished values of 
+         * the mapped Task to a desired type. Note that the function is only 
+         * given a pointer to the finish value, as `T` is not guaranteed to be 
+         * copyable - the mapper may NOT move out of the value!
+         * @param progressMapper Function that converts the progress values of 
+         * the mapped Task to a desired type
+         * @param onCancelled Function that is called if the mapped Task is 
+         * cancelled
+         * @param name The name of the Task; used for debugging. The name of 
+         * the mapped task is appended to the end
+         */
+        template <class ResultMapper, class ProgressMapper, class OnCancelled>
+        auto map(ResultMapper&& resultMapper, ProgressMapper&& progressMapper, OnCancelled&& onCancelled, std::string_view name = "<Mapping Task>") const {
+            return this->mapOn(TaskExecutor::MainThread, std::move(resultMapper), std::move(progressMapper), std::move(onCancelled), name);
+        }
+
         /**
          * Create a new Task that listens to this Task and maps the values using 
          * the provided functions. 
@@ -8,8 +8,12 @@
 #include <matjson.hpp>
 #include "string.hpp"
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 template <>
 struct matjson::Serialize<std::filesystem::path> {
@@ -54,6 +58,93 @@ namespace geode::utils::file {
     GEODE_DLL Result<> writeString(std::filesystem::path const& path, std::string const& data);
     GEODE_DLL Result<> writeBinary(std::filesystem::path const& path, ByteVector const& data);
 
+    /**
+     * How a file should be written
+     */
+    enum class WriteMode {
+        /**
+         * Truncate the file and write the new contents in place. If the game 
+         * crashes halfway through, the file is left half-written
+         */
+        InPlace,
+        /**
+         * Write the new contents to a temporary file in the same directory 
+         * and rename it over the target, so the file always has either its 
+         * old or its new contents. Data may still be lost on power loss
+         */
+        Atomic,
+        /**
+         * Like Atomic, but the new contents and the rename are also flushed 
+         * to disk before returning, so they survive power loss. Slower
+         */
+        AtomicSynced,
+    };
+
+    GEODE_DLL Result<> writeString(std::filesystem::path const& path, std::string const& data, WriteMode mode);
+    GEODE_DLL Result<> writeBinary(std::filesystem::path const& path, ByteVector const& data, WriteMode mode);
+
+    /**
+     * Atomically write many files at once. Every file is written to a 
+     * temporary file first, and all of them are renamed over their targets 
+     * afterwards; with WriteMode::AtomicSynced, each affected directory is 
+     * only flushed once for the whole batch, instead of once per file
+     * @param files The paths and contents of the files to write
+     * @param mode Either WriteMode::Atomic or WriteMode::AtomicSynced; 
+     * WriteMode::InPlace writes every file in place
+     * @returns Ok if every file was written, otherwise an error listing the 
+     * files that weren't. Failing to write one file doesn't stop the others 
+     * from being written
+     */
+    GEODE_DLL Result<> writeFiles(
+        std::vector<std::pair<std::filesystem::path, std::string>> const& files,
+        WriteMode mode = WriteMode::AtomicSynced
+    );
+
+    /**
+     * A read-only view of a file's contents. The file is memory-mapped where 
+     * possible, so reading it doesn't copy it; if mapping fails (for example 
+     * on some special files), the contents are read into memory instead. 
+     * The file can still be written to, replaced or deleted while it's 
+     * mapped, so writing a file atomically doesn't fail because it's open
+     * @warning The file must not be truncated while it's mapped, or reading 
+     * the now missing part crashes the game. Keep MappedFiles short-lived
+     */
+    class GEODE_DLL MappedFile final {
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_impl;
+
+        MappedFile(std::unique_ptr<Impl>&& impl);
+
+    public:
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+        MappedFile(MappedFile&& other);
+        MappedFile& operator=(MappedFile&& other);
+        ~MappedFile();
+
+        /**
+         * Open a file for reading
+         */
+        static Result<MappedFile> open(std::filesystem::path const& path);
+
+        /**
+         * The contents of the file. Valid for as long as this MappedFile is
+         */
+        std::span<const uint8_t> data() const;
+        /**
+         * The contents of the file as text. Valid for as long as this 
+         * MappedFile is
+         */
+        std::string_view text() const;
+        size_t size() const;
+        /**
+         * Whether the file is actually memory-mapped, or if its contents had 
+         * to be read into memory instead
+         */
+        bool isMapped() const;
+    };
+
     template <class T>
     Result<> writeToJson(std::filesystem::path const& path, T const& data) {
         GEODE_UNWRAP(writeString(path, matjson::Value(data).dump()));
@@ -278,18 +369,46 @@ namespace geode::utils::file {
      */
     GEODE_DLL Task<Result<std::vector<std::filesystem::path>>> pickMany(FilePickOptions const& options);
 
+    /**
+     * Identifies a file on disk regardless of the path used to reach it; 
+     * the device and inode on POSIX, the volume serial number and file index 
+     * on Windows
+     */
+    struct FileIdentity {
+        uint64_t device = 0;
+        uint64_t file = 0;
+
+        bool operator==(FileIdentity const&) const = default;
+    };
+
+    /**
+     * Get the identity of a file or directory
+     * @returns The identity, or std::nullopt if the file doesn't exist or 
+     * can't be accessed
+     */
+    GEODE_DLL std::optional<FileIdentity> getFileIdentity(std::filesystem::path const& path);
+
     class GEODE_DLL FileWatchEvent final : public Event {
     protected:
         std::filesystem::path m_path;
+        std::vector<FileIdentity> m_identities;
     
     public:
         FileWatchEvent(std::filesystem::path const& path);
+        /**
+         * @param identities The identities the changed file is known by; 
+         * usually its identity when the watch started and its identity now, 
+         * which differ if the file has been replaced
+         */
+        FileWatchEvent(std::filesystem::path const& path, std::vector<FileIdentity> identities);
         std::filesystem::path getPath() const;
+        std::vector<FileIdentity> const& getIdentities() const;
     };
 
     class GEODE_DLL FileWatchFilter final : public EventFilter<FileWatchEvent> {
     protected:
         std::filesystem::path m_path;
+        std::optional<FileIdentity> m_identity;
     
     public:
         using Callback = void(FileWatchEvent*);
@@ -303,9 +422,10 @@ namespace geode::utils::file {
      * FileWatchEvent is emitted. Add an EventListener with FileWatchFilter 
      * to catch these events
      * @param file The file to watch
-     * @note Watching uses file system equivalence instead of path equivalence, 
-     * so different paths that point to the same file will be considered the 
-     * same
+     * @note Watching uses file identity instead of path equivalence, so 
+     * different paths that point to the same file will be considered the 
+     * same. A file is only watched once no matter how many times this is 
+     * called for it
      */
     GEODE_DLL Result<> watchFile(std::filesystem::path const& file);
     /**
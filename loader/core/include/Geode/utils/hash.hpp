@@ -1,10 +1,48 @@
 #pragma once
 
+#include "../core/Prelude.hpp"
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <filesystem>
 #include <span>
 
 namespace geode::utils {
+    /**
+     * Calculates a SHA256 hash incrementally, as data is fed to it. Uses the 
+     * CPU's SHA extensions (SHA-NI on x86, the SHA2 instructions on ARMv8) 
+     * when it has them, which is several times faster
+     */
+    class GEODE_DLL SHA256Hasher final {
+    private:
+        uint32_t m_state[8];
+        uint8_t m_buffer[64];
+        size_t m_bufferSize;
+        uint64_t m_length;
+
+    public:
+        SHA256Hasher();
+
+        /**
+         * Add data to the hash
+         */
+        void update(std::span<const uint8_t> data);
+        void update(std::string_view data);
+        /**
+         * Get the hash of everything added so far, and reset the hasher so 
+         * it can be reused
+         */
+        std::array<uint8_t, 32> finish();
+        /**
+         * Same as finish, but as a lowercase hex string
+         */
+        std::string finishHex();
+        /**
+         * Discard everything added so far
+         */
+        void reset();
+    };
 
     std::string calculateSHA3_256(std::filesystem::path const& path);
 
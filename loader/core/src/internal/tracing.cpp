@@ -0,0 +1,126 @@
+#include "tracing.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/file.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace geode::prelude;
+
+namespace {
+    struct SpanEvent {
+        std::string name;
+        std::string category;
+        std::string detail;
+        tracing::Clock::time_point start;
+        tracing::Clock::time_point end;
+        uint32_t thread;
+    };
+
+    std::atomic_bool s_enabled = false;
+
+    std::mutex s_mutex;
+    std::vector<SpanEvent> s_events;
+    // Names of the threads spans were recorded on, indexed by their trace ID
+    std::vector<std::string> s_threadNames;
+
+    // Threads get small sequential IDs so the trace viewer lists them in the
+    // order they first did something
+    uint32_t getTraceThreadID() {
+        static thread_local uint32_t id = [] {
+            std::lock_guard lock(s_mutex);
+            s_threadNames.push_back(thread::getName());
+            return static_cast<uint32_t>(s_threadNames.size());
+        }();
+        return id;
+    }
+}
+
+bool tracing::isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void tracing::enable() {
+    s_enabled = true;
+}
+
+void tracing::recordSpan(
+    std::string name, std::string category, std::string detail,
+    Clock::time_point start, Clock::time_point end
+) {
+    auto thread = getTraceThreadID();
+    std::lock_guard lock(s_mutex);
+    // A span may have started before tracing was finished
+    if (!isEnabled()) {
+        return;
+    }
+    s_events.push_back({
+        std::move(name), std::move(category), std::move(detail), start, end, thread
+    });
+}
+
+void tracing::finish() {
+    if (!s_enabled.exchange(false)) {
+        return;
+    }
+
+    std::vector<SpanEvent> events;
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard lock(s_mutex);
+        events.swap(s_events);
+        threadNames = s_threadNames;
+    }
+
+    // Spans may have been recorded for things that started before tracing
+    // was enabled, so the timeline starts at whatever started first
+    auto origin = Clock::time_point::max();
+    for (auto const& event : events) {
+        origin = std::min(origin, event.start);
+    }
+    auto const toMicroseconds = [&](Clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+    };
+
+    auto traceEvents = matjson::Value::array();
+    for (size_t i = 0; i < threadNames.size(); i++) {
+        traceEvents.push(matjson::makeObject({
+            { "name", "thread_name" },
+            { "ph", "M" },
+            { "pid", 1 },
+            { "tid", i + 1 },
+            { "args", matjson::makeObject({ { "name", threadNames[i] } }) },
+        }));
+    }
+    for (auto const& event : events) {
+        auto json = matjson::makeObject({
+            { "name", event.name },
+            { "cat", event.category },
+            { "ph", "X" },
+            { "ts", toMicroseconds(event.start) },
+            { "dur", toMicroseconds(event.end) - toMicroseconds(event.start) },
+            { "pid", 1 },
+            { "tid", event.thread },
+        });
+        if (!event.detail.empty()) {
+            json["args"] = matjson::makeObject({ { "detail", event.detail } });
+        }
+        traceEvents.push(std::move(json));
+    }
+    auto trace = matjson::makeObject({
+        { "traceEvents", traceEvents },
+        { "displayTimeUnit", "ms" },
+    });
+
+    auto path = dirs::getGeodeLogDir() / fmt::format(
+        "Startup trace {:%F %H.%M.%S}.json",
+        fmt::localtime(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()))
+    );
+    if (auto res = file::writeString(path, trace.dump(matjson::NO_INDENTATION)); !res) {
+        log::error("Unable to write startup trace: {}", res.unwrapErr());
+        return;
+    }
+    log::info("Wrote startup trace with {} spans to {}", events.size(), path);
+}
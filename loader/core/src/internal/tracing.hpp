@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Geode/Loader.hpp>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+/**
+ * Records a timeline of what the loader spends its time on during startup,
+ * which can be opened in Perfetto or chrome://tracing. Nothing is recorded
+ * unless the game was launched with --geode:trace-startup
+ */
+namespace tracing {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Whether spans are currently being recorded
+     */
+    bool GEODE_DLL isEnabled();
+    /**
+     * Start recording spans
+     */
+    void GEODE_DLL enable();
+    /**
+     * Stop recording and write everything recorded so far to the logs
+     * directory as Chrome trace event JSON. Does nothing if tracing isn't
+     * enabled
+     */
+    void GEODE_DLL finish();
+
+    void GEODE_DLL recordSpan(
+        std::string name, std::string category, std::string detail,
+        Clock::time_point start, Clock::time_point end
+    );
+
+    /**
+     * Records the time between its construction and destruction. When tracing
+     * is disabled, this only costs a check of whether it's enabled
+     */
+    class Span final {
+    private:
+        bool m_active = false;
+        std::string m_name;
+        std::string m_category;
+        std::string m_detail;
+        Clock::time_point m_start;
+
+    public:
+        /**
+         * @param name What is being done
+         * @param category Group for filtering in the trace viewer
+         * @param detail Extra information shown when the span is selected,
+         * like which mod it's for
+         */
+        Span(std::string_view name, std::string_view category, std::string_view detail = {}) {
+            if (isEnabled()) {
+                m_active = true;
+                m_name = name;
+                m_category = category;
+                m_detail = detail;
+                m_start = Clock::now();
+            }
+        }
+        Span(Span const&) = delete;
+        Span& operator=(Span const&) = delete;
+
+        ~Span() {
+            if (m_active) {
+                recordSpan(
+                    std::move(m_name), std::move(m_category), std::move(m_detail),
+                    m_start, Clock::now()
+                );
+            }
+        }
+    };
+}
@@ -9,6 +9,7 @@
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <loader/LogImpl.hpp>
+#include <internal/tracing.hpp>
 
 #include <array>
 
@@ -134,6 +135,9 @@ int geodeEntry(void* platformData) {
     tryLogForwardCompat();
 
     auto begin = std::chrono::high_resolution_clock::now();
+    // tracing is only enabled once launch arguments have been read during
+    // setup, so the span covering all of this is recorded manually
+    auto traceBegin = tracing::Clock::now();
 
     // set up internal mod, settings and data
     log::info("Setting up internal mod");
@@ -196,6 +200,7 @@ int geodeEntry(void* platformData) {
     log::debug("Setting up IPC");
     {
         log::NestScope nest;
+        tracing::Span span("Set up IPC", "loader");
         ipc::setup();
     }
 
@@ -212,6 +217,9 @@ int geodeEntry(void* platformData) {
     auto end = std::chrono::high_resolution_clock::now();
     auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
     log::info("Entry took {}s", static_cast<float>(time) / 1000.f);
+    if (tracing::isEnabled()) {
+        tracing::recordSpan("Entry", "loader", "", traceBegin, tracing::Clock::now());
+    }
 
     // also log after entry so that users are more likely to notice
     tryLogForwardCompat();
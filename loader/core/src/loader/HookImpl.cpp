@@ -1,8 +1,36 @@
 #include "HookImpl.hpp"
 
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/utils/file.hpp>
+#include <chrono>
+#include <fmt/chrono.h>
+#include <map>
+#include <mutex>
 #include <utility>
 #include "LoaderImpl.hpp"
 
+namespace {
+    struct HookProfile {
+        std::string displayName = "<unknown>";
+        std::string modID = "<unknown>";
+        std::unique_ptr<geode_internal::HookProfileSlot> slot = std::make_unique<geode_internal::HookProfileSlot>();
+    };
+
+    std::atomic_bool s_profilingEnabled = false;
+    std::mutex s_profilesMutex;
+    // Keyed by detour, since that's all the generated detours know about 
+    // themselves; the slots are never freed so detours can cache them
+    std::unordered_map<void*, HookProfile> s_profiles;
+}
+
+geode_internal::HookProfileSlot* geode_internal::getHookProfileSlot(void* detour) {
+    if (!s_profilingEnabled) {
+        return nullptr;
+    }
+    std::lock_guard lock(s_profilesMutex);
+    return s_profiles[detour].slot.get();
+}
+
 Hook::Impl::Impl(
     void* address,
     void* detour,
@@ -49,25 +77,12 @@ Result<> Hook::Impl::enable() {
         return Ok();
     }
 
-    // During a transition between updates when it's important to get a
-    // non-functional version that compiles, address 0x9999999 is used to mark
-    // functions not yet RE'd but that would prevent compilation
-    if ((uintptr_t)m_address == (geode::base::get() + 0x9999999)) {
-        if (m_owner) {
-            log::warn(
-                "Hook {} for {} uses placeholder address, refusing to hook",
-                m_displayName, m_owner->getID()
-            );
-        }
-        else {
-            log::warn("Hook {} uses placeholder address, refusing to hook", m_displayName);
-        }
+    if (this->usesPlaceholderAddress()) {
         return Ok();
     }
 
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getOrCreateHandler(m_address, m_handlerMetadata));
-    m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
-    m_enabled = true;
+    this->enableOnHandler(handler);
 
     if (m_owner) {
         log::debug("Enabled {} hook at {} for {}", m_displayName, m_address, m_owner->getID());
@@ -79,9 +94,195 @@ Result<> Hook::Impl::enable() {
     return Ok();
 }
 
+bool Hook::Impl::usesPlaceholderAddress() const {
+    // During a transition between updates when it's important to get a
+    // non-functional version that compiles, address 0x9999999 is used to mark
+    // functions not yet RE'd but that would prevent compilation
+    if ((uintptr_t)m_address != (geode::base::get() + 0x9999999)) {
+        return false;
+    }
+    if (m_owner) {
+        log::warn(
+            "Hook {} for {} uses placeholder address, refusing to hook",
+            m_displayName, m_owner->getID()
+        );
+    }
+    else {
+        log::warn("Hook {} uses placeholder address, refusing to hook", m_displayName);
+    }
+    return true;
+}
+
+void Hook::Impl::enableOnHandler(tulip::hook::HandlerHandle handler) {
+    if (s_profilingEnabled) {
+        std::lock_guard lock(s_profilesMutex);
+        auto& profile = s_profiles[m_detour];
+        profile.displayName = m_displayName;
+        profile.modID = m_owner ? m_owner->getID() : "<unowned>";
+    }
+    m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
+    m_enabled = true;
+}
+
+bool Hook::Impl::enableAll(std::vector<std::pair<Hook*, Mod*>> const& hooks) {
+    using Clock = std::chrono::steady_clock;
+    auto const msSince = [](Clock::time_point since) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - since).count() / 1000.0;
+    };
+
+    bool hadErrors = false;
+    size_t skipped = 0;
+    size_t failed = 0;
+
+    // Group hooks by the address they target, keeping the order in which 
+    // addresses were first seen so hooking stays deterministic
+    auto groupStart = Clock::now();
+    std::vector<void*> addresses;
+    std::unordered_map<void*, std::vector<std::pair<Impl*, Mod*>>> groups;
+    for (auto const& [hook, mod] : hooks) {
+        auto impl = hook->m_impl.get();
+        if (impl->m_enabled || impl->usesPlaceholderAddress()) {
+            skipped += 1;
+            continue;
+        }
+        auto& group = groups[impl->m_address];
+        if (group.empty()) {
+            addresses.push_back(impl->m_address);
+        }
+        group.emplace_back(impl, mod);
+    }
+    auto groupTime = msSince(groupStart);
+
+    // Create (or grab) every handler once for all of the hooks on its address; 
+    // this is where the game's code actually gets patched. Like with enabling 
+    // hooks one by one, the first hook on an address decides the handler's 
+    // metadata
+    auto handlerStart = Clock::now();
+    std::vector<std::pair<void*, tulip::hook::HandlerHandle>> handlers;
+    handlers.reserve(addresses.size());
+    for (auto address : addresses) {
+        auto& group = groups.at(address);
+        auto res = LoaderImpl::get()->getOrCreateHandler(address, group.front().first->m_handlerMetadata, group.size());
+        if (!res) {
+            for (auto const& [impl, mod] : group) {
+                log::logImpl(Severity::Error, mod, "Failed to enable {} hook: {}", impl->m_displayName, res.unwrapErr());
+            }
+            failed += group.size();
+            hadErrors = true;
+            continue;
+        }
+        handlers.emplace_back(address, res.unwrap());
+    }
+    auto handlerTime = msSince(handlerStart);
+
+    // Add hooks to their handler in priority order, so the handler's list of 
+    // hooks is built in order instead of being reshuffled on every insert
+    auto hookStart = Clock::now();
+    size_t enabled = 0;
+    for (auto const& [address, handler] : handlers) {
+        auto& group = groups.at(address);
+        std::stable_sort(group.begin(), group.end(), [](auto const& a, auto const& b) {
+            return a.first->m_hookMetadata.m_priority < b.first->m_hookMetadata.m_priority;
+        });
+        for (auto const& [impl, mod] : group) {
+            impl->enableOnHandler(handler);
+        }
+        enabled += group.size();
+    }
+    auto hookTime = msSince(hookStart);
+
+    log::debug(
+        "Enabled {} hooks on {} addresses ({} skipped, {} failed) - "
+        "grouping took {:.2f}ms, handlers {:.2f}ms, hooks {:.2f}ms",
+        enabled, handlers.size(), skipped, failed, groupTime, handlerTime, hookTime
+    );
+
+    return !hadErrors;
+}
+
+void Hook::Impl::enableProfiling() {
+    s_profilingEnabled = true;
+}
+
+bool Hook::Impl::isProfilingEnabled() {
+    return s_profilingEnabled;
+}
+
+void Hook::Impl::writeProfileReport() {
+    if (!s_profilingEnabled) {
+        return;
+    }
+
+    struct Entry {
+        std::string_view displayName;
+        std::string_view modID;
+        uint64_t calls;
+        double averageUs;
+        double totalMs;
+    };
+    std::vector<Entry> entries;
+    std::map<std::string_view, std::pair<uint64_t, double>> modTotals;
+
+    std::lock_guard lock(s_profilesMutex);
+    for (auto const& [_, profile] : s_profiles) {
+        auto calls = profile.slot->calls.load(std::memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+        // Only a fraction of calls are timed, so scale the average up to 
+        // estimate the total
+        auto sampled = profile.slot->sampledCalls.load(std::memory_order_relaxed);
+        auto nanos = profile.slot->sampledNanoseconds.load(std::memory_order_relaxed);
+        auto averageUs = sampled ? nanos / 1000.0 / sampled : 0.0;
+        auto totalMs = averageUs * calls / 1000.0;
+        entries.push_back({ profile.displayName, profile.modID, calls, averageUs, totalMs });
+
+        auto& total = modTotals[profile.modID];
+        total.first += calls;
+        total.second += totalMs;
+    }
+    std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b) {
+        return a.totalMs > b.totalMs;
+    });
+    std::vector<std::pair<std::string_view, std::pair<uint64_t, double>>> mods(modTotals.begin(), modTotals.end());
+    std::sort(mods.begin(), mods.end(), [](auto const& a, auto const& b) {
+        return a.second.second > b.second.second;
+    });
+
+    std::string report = fmt::format(
+        "Hook profile - every {}th call is timed, times include everything the "
+        "hook calls (including the original)\n\n",
+        geode_internal::HookProfileScope::SAMPLE_INTERVAL
+    );
+    report += fmt::format("{:>12} {:>12}  {}\n", "Calls", "Total (ms)", "Mod");
+    for (auto const& [modID, total] : mods) {
+        report += fmt::format("{:>12} {:>12.2f}  {}\n", total.first, total.second, modID);
+    }
+    report += fmt::format("\n{:>12} {:>12} {:>12}  {}\n", "Calls", "Avg (us)", "Total (ms)", "Hook");
+    for (auto const& entry : entries) {
+        report += fmt::format(
+            "{:>12} {:>12.3f} {:>12.2f}  {} ({})\n",
+            entry.calls, entry.averageUs, entry.totalMs, entry.displayName, entry.modID
+        );
+    }
+
+    auto path = dirs::getGeodeLogDir() / fmt::format(
+        "Hook profile {:%F %H.%M.%S}.txt",
+        fmt::localtime(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()))
+    );
+    if (auto res = utils::file::writeString(path, report); !res) {
+        log::error("Unable to write hook profile: {}", res.unwrapErr());
+        return;
+    }
+    log::info("Wrote hook profile for {} hooks to {}", entries.size(), path);
+}
+
 Result<> Hook::Impl::disable() {
-    if (!m_enabled)
+    if (!m_enabled) {
+        // the hook may still be waiting to be enabled in a batch
+        LoaderImpl::get()->removeUninitializedHook(m_self);
         return Ok();
+    }
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getAndDecreaseHandler(m_address));
     tulip::hook::removeHook(handler, m_handle);
     m_enabled = false;
@@ -50,6 +50,31 @@ public:
     Result<> enable();
     Result<> disable();
 
+    bool usesPlaceholderAddress() const;
+    void enableOnHandler(tulip::hook::HandlerHandle handler);
+
+    /**
+     * Enable many hooks at once. Hooks are grouped by address so that the 
+     * handler for each address is only created once, and are then added to 
+     * their handler in priority order. Errors are logged for the mod that 
+     * owns the failing hook
+     * @returns True if every hook was enabled without errors
+     */
+    static bool enableAll(std::vector<std::pair<Hook*, Mod*>> const& hooks);
+
+    /**
+     * Start collecting call counts and timings for hooks; must be called 
+     * before any hooks are enabled. Only hooks made with Modify in mods 
+     * built against an SDK that has the profiler are tracked
+     */
+    static void enableProfiling();
+    static bool isProfilingEnabled();
+    /**
+     * Write the collected hook profile, sorted by estimated total time, to 
+     * the logs directory
+     */
+    static void writeProfileReport();
+
     uintptr_t getAddress() const;
     std::string_view getDisplayName() const;
     matjson::Value getRuntimeInfo() const;
@@ -1,5 +1,6 @@
 #include "LoaderImpl.hpp"
 
+#include "HookImpl.hpp"
 #include "ModImpl.hpp"
 #include "ModMetadataImpl.hpp"
 #include "LogImpl.hpp"
@@ -19,14 +20,18 @@
 #include <Geode/utils/web.hpp>
 #include <internal/about.hpp>
 #include <internal/crashlog.hpp>
+#include <internal/tracing.hpp>
 #include <fmt/format.h>
 #include <Geode/utils/hash.hpp>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <iterator>
 #include <optional>
 #include <internal/resources.hpp>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include <server/DownloadManager.hpp>
@@ -94,10 +99,21 @@ Result<> Loader::Impl::setup() {
         this->initLaunchArguments();
     }
 
+    if (this->getLaunchFlag("profile-hooks")) {
+        log::info("Hook profiling enabled");
+        Hook::Impl::enableProfiling();
+    }
+
+    if (this->getLaunchFlag("trace-startup")) {
+        log::info("Startup tracing enabled");
+        tracing::enable();
+    }
+
     // on some platforms, using the crash handler overrides more convenient native handlers
     if (!this->getLaunchFlag("disable-crash-handler")) {
         log::info("Setting up crash handler");
         log::NestScope nest;
+        tracing::Span span("Set up crash handler", "loader");
         if (!crashlog::setupPlatformHandler()) {
             log::debug("Failed to set up crash handler");
         }
@@ -113,6 +129,7 @@ Result<> Loader::Impl::setup() {
     log::info("Setting up directories");
     {
         log::NestScope nest;
+        tracing::Span span("Set up directories", "loader");
         this->createDirectories();
         this->removeDirectories();
         this->addSearchPaths();
@@ -125,6 +142,12 @@ Result<> Loader::Impl::setup() {
     log::info("Refreshing mod graph");
     this->refreshModGraph();
 
+    // covers every way the game can quit, including the ones that never
+    // go through trySaveGame, like closing the window on Windows
+    std::atexit([] {
+        LoaderImpl::get()->shutdown();
+    });
+
     m_isSetup = true;
 
     return Ok();
@@ -186,17 +209,99 @@ bool Loader::Impl::isModVersionSupported(VersionInfo const& target) {
 
 // Data saving
 
+static void writeDataFiles(std::map<std::filesystem::path, std::string>&& writes) {
+    if (writes.empty()) return;
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
+    files.reserve(writes.size());
+    for (auto& [path, data] : writes) {
+        files.emplace_back(path, std::move(data));
+    }
+    // all files are written atomically and flushed to disk, so neither a
+    // crash nor a power loss halfway through can leave a truncated file
+    // behind, while the directories are only synced once per batch
+    if (auto res = utils::file::writeFiles(files, utils::file::WriteMode::AtomicSynced); !res) {
+        log::error("Unable to save mod data: {}", res.unwrapErr());
+    }
+}
+
 void Loader::Impl::saveData() {
+    this->saveDataAsync();
+    this->flushDataWrites();
+}
+
+void Loader::Impl::saveDataAsync() {
+    size_t changed = 0;
     for (auto& [id, mod] : m_mods) {
-        log::debug("{}", mod->getID());
-        log::NestScope nest;
-        auto r = mod->saveData();
-        if (!r) {
-            log::warn("Unable to save data for mod \"{}\": {}", mod->getID(), r.unwrapErr());
+        auto writes = ModImpl::getImpl(mod)->serializeData();
+        if (!writes.empty()) {
+            log::debug("{}", mod->getID());
+            changed += 1;
         }
+        this->queueDataWrites(std::move(writes));
+    }
+    log::debug("{} mods had changed data", changed);
+
+    std::lock_guard lock(m_dataWriteMutex);
+    if (!m_dataWriterStarted && !m_pendingDataWrites.empty()) {
+        m_dataWriterStarted = true;
+        std::thread([this]() {
+            thread::setName("Mod Data Writer");
+            while (true) {
+                std::unique_lock lock(m_dataWriteMutex);
+                m_dataWriteCV.wait(lock, [this] {
+                    return !m_pendingDataWrites.empty() && !m_dataWriteInProgress;
+                });
+                auto writes = std::move(m_pendingDataWrites);
+                m_pendingDataWrites.clear();
+                m_dataWriteInProgress = true;
+                lock.unlock();
+
+                writeDataFiles(std::move(writes));
+
+                lock.lock();
+                m_dataWriteInProgress = false;
+                lock.unlock();
+                m_dataWriteCV.notify_all();
+            }
+        }).detach();
+    }
+    m_dataWriteCV.notify_all();
+}
+
+void Loader::Impl::queueDataWrites(std::vector<std::pair<std::filesystem::path, std::string>>&& writes) {
+    if (writes.empty()) return;
+    std::lock_guard lock(m_dataWriteMutex);
+    for (auto& [path, data] : writes) {
+        // only the latest contents of a file matter
+        m_pendingDataWrites[path] = std::move(data);
     }
 }
 
+void Loader::Impl::flushDataWrites() {
+    std::unique_lock lock(m_dataWriteMutex);
+    // wait for the background writer to finish whatever it's currently
+    // writing, so it can't overwrite newer data afterwards
+    m_dataWriteCV.wait(lock, [this] { return !m_dataWriteInProgress; });
+    auto writes = std::move(m_pendingDataWrites);
+    m_pendingDataWrites.clear();
+    m_dataWriteInProgress = true;
+    lock.unlock();
+
+    writeDataFiles(std::move(writes));
+
+    lock.lock();
+    m_dataWriteInProgress = false;
+    lock.unlock();
+    m_dataWriteCV.notify_all();
+}
+
+void Loader::Impl::shutdown() {
+    // the background writer is detached, so anything it hasn't written yet
+    // would be lost once the process exits
+    this->flushDataWrites();
+    Hook::Impl::writeProfileReport();
+}
+
 void Loader::Impl::loadData() {
     for (auto& [_, mod] : m_mods) {
         log::debug("{}", mod->getID());
@@ -394,7 +499,8 @@ void Loader::Impl::buildModGraph() {
     }
 }
 
-void Loader::Impl::loadModGraph(Mod* node, bool early) {
+// Checks whether the mod can be loaded at all, and counts it as being loaded if so
+bool Loader::Impl::prepareModLoad(Mod* node, bool early) {
     // Check version first, as it's not worth trying to load a mod with an 
     // invalid target version
     // Also this makes it so that when GD updates, outdated mods get shown as 
@@ -407,7 +513,7 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
             res.unwrapErr()
         });
         log::error("{}", res.unwrapErr());
-        return;
+        return false;
     }
 
     auto geodeVerRes = node->getMetadata().checkGeodeVersion();
@@ -420,55 +526,27 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
             geodeVerRes.unwrapErr()
         });
         log::error("{}", geodeVerRes.unwrapErr());
-        return;
+        return false;
     }
     
     if (node->hasUnresolvedDependencies()) {
         log::warn("{} {} has unresolved dependencies", node->getID(), node->getVersion());
-        return;
+        return false;
     }
     if (node->hasUnresolvedIncompatibilities()) {
         log::warn("{} {} has unresolved incompatibilities", node->getID(), node->getVersion());
-        return;
+        return false;
     }
 
-    log::NestScope nest;
-
     if (node->isEnabled()) {
         log::error("Mod {} already loaded, this should never happen", node->getID());
-        return;
+        return false;
     }
 
-    m_currentlyLoadingMod = node;
     m_refreshingModCount += 1;
     m_refreshedModCount += 1;
     m_lateRefreshedModCount += early ? 0 : 1;
 
-    auto unzipFunction = [this, node]() {
-        log::debug("Unzipping .geode file");
-        auto res = node->m_impl->unzipGeodeFile(node->getMetadata());
-        return res;
-    };
-
-    auto loadFunction = [this, node, early]() {
-        if (node->shouldLoad()) {
-            log::debug("Loading binary");
-            auto res = node->m_impl->loadBinary();
-            if (!res) {
-                this->addProblem({
-                    LoadProblem::Type::LoadFailed,
-                    node,
-                    res.unwrapErr()
-                });
-                log::error("Failed to load binary: {}", res.unwrapErr());
-                m_refreshingModCount -= 1;
-                return;
-            }
-        }
-
-        m_refreshingModCount -= 1;
-    };
-
     {   // version checking
         if (auto reason = node->getMetadata().m_impl->m_softInvalidReason) {
             this->addProblem({
@@ -478,49 +556,125 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
             });
             log::error("{}", reason.value());
             m_refreshingModCount -= 1;
-            return;
+            return false;
         }
     }
+    return true;
+}
+
+// Safe to call from any thread
+Result<> Loader::Impl::unzipMod(Mod* node) {
+    log::debug("Unzipping .geode file");
+    tracing::Span span("Unzip mod", "mods", node->getID());
+    return node->m_impl->unzipGeodeFile(node->getMetadata());
+}
 
-    if (early) {
-        auto res = unzipFunction();
+void Loader::Impl::loadModBinary(Mod* node) {
+    tracing::Span span("Load mod", "mods", node->getID());
+    // a whole level is prepared before any of it is loaded, so this is only
+    // set once the mod's binary is actually about to be loaded
+    m_currentlyLoadingMod = node;
+    if (node->shouldLoad()) {
+        log::debug("Loading binary");
+        auto res = node->m_impl->loadBinary();
         if (!res) {
             this->addProblem({
-                LoadProblem::Type::UnzipFailed,
+                LoadProblem::Type::LoadFailed,
                 node,
                 res.unwrapErr()
             });
-            log::error("Failed to unzip: {}", res.unwrapErr());
-            m_refreshingModCount -= 1;
-            return;
+            log::error("Failed to load binary: {}", res.unwrapErr());
         }
-        loadFunction();
     }
-    else {
-        auto nest = log::saveNest();
-        std::thread([=, this]() {
-            thread::setName("Mod Unzip");
-            log::loadNest(nest);
-            auto res = unzipFunction();
-            this->queueInMainThread([=, this, res = std::move(res)]() {
-                auto prevNest = log::saveNest();
+    m_refreshingModCount -= 1;
+}
+
+void Loader::Impl::loadModGraph(Mod* node, bool early) {
+    log::NestScope nest;
+    if (!this->prepareModLoad(node, early)) {
+        return;
+    }
+
+    auto res = this->unzipMod(node);
+    if (!res) {
+        this->addProblem({
+            LoadProblem::Type::UnzipFailed,
+            node,
+            res.unwrapErr()
+        });
+        log::error("Failed to unzip: {}", res.unwrapErr());
+        m_refreshingModCount -= 1;
+        return;
+    }
+    this->loadModBinary(node);
+}
+
+void Loader::Impl::loadModLevel(std::vector<Mod*> const& level) {
+    std::vector<Mod*> mods;
+    for (auto mod : level) {
+        log::info("Loading mod {} {}", mod->getID(), mod->getVersion());
+        log::NestScope nest;
+        if (this->prepareModLoad(mod, false)) {
+            mods.push_back(mod);
+        }
+    }
+    if (mods.empty()) {
+        return;
+    }
+
+    // every mod in a level only depends on earlier levels, so the whole level
+    // can be unzipped at the same time, by a bounded number of threads
+    auto nest = log::saveNest();
+    std::thread([this, mods = std::move(mods), nest]() {
+        thread::setName("Mod Unzip");
+        log::loadNest(nest);
+
+        std::vector<std::optional<std::string>> errors(mods.size());
+        std::atomic_size_t nextToUnzip = 0;
+        auto const unzip = [&]() {
+            for (size_t i = nextToUnzip++; i < mods.size(); i = nextToUnzip++) {
+                if (auto res = this->unzipMod(mods[i]); !res) {
+                    errors[i] = res.unwrapErr();
+                }
+            }
+        };
+        auto threadCount = std::min<size_t>(
+            mods.size(), std::max(std::thread::hardware_concurrency(), 1u)
+        );
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < threadCount; i++) {
+            workers.emplace_back([&]() {
+                thread::setName("Mod Unzip");
                 log::loadNest(nest);
-                if (!res) {
+                unzip();
+            });
+        }
+        unzip();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // binaries are loaded in level order, so hooks are always enabled
+        // in the same order no matter which unzip finished first
+        this->queueInMainThread([this, mods, errors = std::move(errors), nest]() {
+            auto prevNest = log::saveNest();
+            log::loadNest(nest);
+            for (size_t i = 0; i < mods.size(); i++) {
+                if (errors[i]) {
                     this->addProblem({
                         LoadProblem::Type::UnzipFailed,
-                        node,
-                        res.unwrapErr()
+                        mods[i],
+                        *errors[i]
                     });
-                    log::error("Failed to unzip: {}", res.unwrapErr());
+                    log::error("Failed to unzip {}: {}", mods[i]->getID(), *errors[i]);
                     m_refreshingModCount -= 1;
-                    log::loadNest(prevNest);
-                    return;
+                    continue;
                 }
-                loadFunction();
-                log::loadNest(prevNest);
-            });
-        }).detach();
-    }
+                this->loadModBinary(mods[i]);
+            }
+            log::loadNest(prevNest);
+        });
+    }).detach();
 }
 
 void Loader::Impl::findProblems() {
@@ -673,6 +827,7 @@ void Loader::Impl::refreshModGraph() {
     }
 
     auto begin = std::chrono::high_resolution_clock::now();
+    tracing::Span span("Refresh mod graph", "loader");
 
     m_problems.clear();
 
@@ -681,6 +836,7 @@ void Loader::Impl::refreshModGraph() {
     std::vector<ModMetadata> modQueue;
     {
         log::NestScope nest;
+        tracing::Span span("Queue mods", "loader");
         this->queueMods(modQueue);
     }
 
@@ -688,6 +844,7 @@ void Loader::Impl::refreshModGraph() {
     log::info("Populating mod list");
     {
         log::NestScope nest;
+        tracing::Span span("Populate mod list", "loader");
         this->populateModList(modQueue);
         modQueue.clear();
     }
@@ -696,12 +853,14 @@ void Loader::Impl::refreshModGraph() {
     log::info("Building mod graph");
     {
         log::NestScope nest;
+        tracing::Span span("Build mod graph", "loader");
         this->buildModGraph();
     }
 
     log::info("Ordering mod stack");
     {
         log::NestScope nest;
+        tracing::Span span("Order mod stack", "loader");
         this->orderModStack();
     }
 
@@ -709,11 +868,13 @@ void Loader::Impl::refreshModGraph() {
     log::info("Loading early mods");
     {
         log::NestScope nest;
-        while (!m_modsToLoad.empty() && m_modsToLoad.front()->needsEarlyLoad()) {
-            auto mod = m_modsToLoad.front();
-            m_modsToLoad.pop_front();
-            log::info("Loading mod {} {}", mod->getID(), mod->getVersion());
-            this->loadModGraph(mod, true);
+        tracing::Span span("Load early mods", "loader");
+        for (auto const& level : m_modLoadLevels) {
+            for (auto mod : level) {
+                if (!m_earlyLoadMods.contains(mod)) break;
+                log::info("Loading mod {} {}", mod->getID(), mod->getVersion());
+                this->loadModGraph(mod, true);
+            }
         }
     }
 
@@ -730,49 +891,146 @@ void Loader::Impl::refreshModGraph() {
 }
 
 void Loader::Impl::orderModStack() {
-    std::unordered_set<Mod*> visited;
-    visited.insert(Mod::get());
-    Mod* selectedMod = nullptr;
-    do {
-        selectedMod = nullptr;
-        for (auto const& mod : ModImpl::get()->m_dependants) {
-            if (visited.count(mod) != 0) continue;
-
-            for (auto dep : mod->getMetadata().getDependencies()) {
-                if (dep.mod && dep.importance == ModMetadata::Dependency::Importance::Required && 
-                    visited.count(dep.mod) == 0) {
-                    // the dependency is not visited yet
-                    // so we cant select this mod
-                    goto skip_mod;
-                }
+    m_modLoadLevels.clear();
+    m_earlyLoadMods.clear();
+    m_modsToLoad.clear();
+
+    auto const& mods = ModImpl::get()->m_dependants;
+    std::unordered_set<Mod*> nodes(mods.begin(), mods.end());
+
+    // only required dependencies order the graph; the cycle check below
+    // has to look at exactly the same edges
+    auto const isRequired = [](ModMetadata::Dependency const& dep) {
+        return dep.mod && dep.importance == ModMetadata::Dependency::Importance::Required && dep.mod != Mod::get();
+    };
+
+    // Kahn's algorithm; in-degree is the number of required dependencies
+    // that haven't been placed in a level yet
+    std::unordered_map<Mod*, size_t> inDegree;
+    std::unordered_map<Mod*, std::vector<Mod*>> dependants;
+    std::vector<Mod*> current;
+    for (auto mod : mods) {
+        size_t degree = 0;
+        bool satisfiable = true;
+        for (auto const& dep : mod->getMetadata().getDependencies()) {
+            if (!isRequired(dep)) {
+                continue;
             }
+            // depends on something that will never be loaded through the loader
+            if (!nodes.contains(dep.mod)) {
+                satisfiable = false;
+                continue;
+            }
+            dependants[dep.mod].push_back(mod);
+            degree += 1;
+        }
+        if (!satisfiable) {
+            // never reaches zero, so it (and everything depending on it) is skipped
+            degree += 1;
+        }
+        inDegree[mod] = degree;
+        if (degree == 0) {
+            current.push_back(mod);
+        }
+    }
 
-            if (selectedMod) {
-                if (
-                    !selectedMod->m_impl->needsEarlyLoad() &&
-                    mod->m_impl->needsEarlyLoad()
-                ) {
-                    // this mod is implied to be loaded early
-                    // so we can override a mod that is not
-                    selectedMod = mod;
+    std::vector<Mod*> order;
+    order.reserve(mods.size());
+    while (!current.empty()) {
+        std::vector<Mod*> next;
+        for (auto mod : current) {
+            order.push_back(mod);
+            for (auto dependant : dependants[mod]) {
+                if (--inDegree[dependant] == 0) {
+                    next.push_back(dependant);
                 }
             }
+        }
+        m_modLoadLevels.push_back(std::move(current));
+        current = std::move(next);
+    }
+
+    // a mod needs to be loaded early if it or anything depending on it does;
+    // walking the order backwards means every dependant has been decided already
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto mod = *it;
+        bool early = mod->getMetadata().needsEarlyLoad();
+        for (auto dependant : dependants[mod]) {
+            early = early || m_earlyLoadMods.contains(dependant);
+        }
+        if (early) {
+            m_earlyLoadMods.insert(mod);
+        }
+    }
+
+    // whatever is left either sits on a cycle or depends on one; peel off
+    // the mods that nothing left depends on until only the cycles remain
+    std::unordered_set<Mod*> blocked;
+    for (auto& [mod, degree] : inDegree) {
+        if (degree > 0) blocked.insert(mod);
+    }
+    auto const isCycleEdge = [&](ModMetadata::Dependency const& dep, std::unordered_set<Mod*> const& set) {
+        return isRequired(dep) && set.contains(dep.mod);
+    };
+    std::unordered_set<Mod*> cyclic;
+    for (auto mod : blocked) {
+        for (auto const& dep : mod->getMetadata().getDependencies()) {
+            if (isCycleEdge(dep, blocked)) cyclic.insert(dep.mod);
+        }
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto it = cyclic.begin(); it != cyclic.end();) {
+            bool hasDependant = ranges::contains(dependants[*it], [&](Mod* d) { return cyclic.contains(d); });
+            bool hasDependency = ranges::contains(
+                (*it)->getMetadata().getDependencies(),
+                [&](ModMetadata::Dependency const& dep) { return isCycleEdge(dep, cyclic); }
+            );
+            if (!hasDependant || !hasDependency) {
+                it = cyclic.erase(it);
+                changed = true;
+            }
             else {
-                selectedMod = mod;
+                ++it;
             }
-
-        skip_mod:
-            continue;
         }
+    }
+    for (auto mod : cyclic) {
+        std::vector<std::string> ids;
+        for (auto const& dep : mod->getMetadata().getDependencies()) {
+            if (isCycleEdge(dep, cyclic)) ids.push_back(dep.id);
+        }
+        auto message = fmt::format("{} -> {}", mod->getID(), fmt::join(ids, ", "));
+        this->addProblem({
+            LoadProblem::Type::DependencyCycle,
+            mod,
+            message
+        });
+        log::error("Dependency cycle: {}", message);
+    }
 
-        if (selectedMod) {
-            m_modsToLoad.push_back(selectedMod);
-            visited.insert(selectedMod);
+    // early mods always come first within a level, and are loaded before any
+    // non-early mod, so only the non-early ones are queued as waves here
+    for (auto& level : m_modLoadLevels) {
+        std::stable_partition(level.begin(), level.end(), [this](Mod* mod) {
+            return m_earlyLoadMods.contains(mod);
+        });
+        std::vector<Mod*> late;
+        for (auto mod : level) {
+            if (!m_earlyLoadMods.contains(mod)) late.push_back(mod);
+        }
+        if (!late.empty()) {
+            m_modsToLoad.push_back(std::move(late));
         }
-    } while (selectedMod != nullptr);
+    }
 
-    for (auto mod : m_modsToLoad) {
-        log::debug("{}, early: {}", mod->getID(), mod->needsEarlyLoad());
+    for (size_t i = 0; i < m_modLoadLevels.size(); i++) {
+        log::debug("Level {}", i);
+        log::NestScope nest;
+        for (auto mod : m_modLoadLevels[i]) {
+            log::debug("{}, early: {}", mod->getID(), m_earlyLoadMods.contains(mod));
+        }
     }
 }
 
@@ -798,10 +1056,10 @@ void Loader::Impl::continueRefreshModGraph() {
     switch (m_loadingState) {
         case LoadingState::Mods:
             if (!m_modsToLoad.empty()) {
-                auto mod = m_modsToLoad.front();
+                auto level = std::move(m_modsToLoad.front());
                 m_modsToLoad.pop_front();
-                log::info("Loading mod {} {}", mod->getID(), mod->getVersion());
-                this->loadModGraph(mod, false);
+                tracing::Span span("Load mod level", "loader", fmt::format("{} mods", level.size()));
+                this->loadModLevel(level);
                 break;
             }
             m_loadingState = LoadingState::Problems;
@@ -810,6 +1068,7 @@ void Loader::Impl::continueRefreshModGraph() {
             log::info("Finding problems");
             {
                 log::NestScope nest;
+                tracing::Span span("Find problems", "loader");
                 this->findProblems();
             }
             m_loadingState = LoadingState::Done;
@@ -857,16 +1116,30 @@ void Loader::Impl::addUninitializedHook(Hook* hook, Mod* mod) {
 
 bool Loader::Impl::loadHooks() {
     m_readyToHook = true;
-    bool hadErrors = false;
-    for (auto const& [hook, mod] : m_uninitializedHooks) {
-        auto res = hook->enable();
-        if (!res) {
-            log::logImpl(Severity::Error, mod, "{}", res.unwrapErr());
-            hadErrors = true;
-        }
-    }
+    return this->enableUninitializedHooks();
+}
+
+bool Loader::Impl::enableUninitializedHooks() {
+    tracing::Span span("Enable hooks", "hooks");
+    auto hooks = std::move(m_uninitializedHooks);
     m_uninitializedHooks.clear();
-    return !hadErrors;
+    // auto enabling may have been turned off after the hook was queued
+    std::erase_if(hooks, [](auto const& pair) {
+        return !pair.first->getAutoEnable();
+    });
+    return Hook::Impl::enableAll(hooks);
+}
+
+void Loader::Impl::removeUninitializedHooks(Mod* mod) {
+    std::erase_if(m_uninitializedHooks, [mod](auto const& pair) {
+        return pair.second == mod;
+    });
+}
+
+void Loader::Impl::removeUninitializedHook(Hook* hook) {
+    std::erase_if(m_uninitializedHooks, [hook](auto const& pair) {
+        return pair.first == hook;
+    });
 }
 
 void Loader::Impl::queueInMainThread(ScheduledFunction&& func) {
@@ -884,6 +1157,7 @@ void Loader::Impl::executeMainThreadQueue() {
 
     // call queue
     for (auto const& func : queue) {
+        tracing::Span span("Main thread queue item", "queue");
         func();
     }
 }
@@ -958,14 +1232,14 @@ Result<tulip::hook::HandlerHandle> Loader::Impl::getHandler(void* address) {
     return Ok(m_handlerHandles[address].first);
 }
 
-Result<tulip::hook::HandlerHandle> Loader::Impl::getOrCreateHandler(void* address, tulip::hook::HandlerMetadata const& metadata) {
+Result<tulip::hook::HandlerHandle> Loader::Impl::getOrCreateHandler(void* address, tulip::hook::HandlerMetadata const& metadata, size_t hookCount) {
     if (m_handlerHandles.count(address) && m_handlerHandles[address].second > 0) {
-        m_handlerHandles[address].second++;
+        m_handlerHandles[address].second += hookCount;
         return Ok(m_handlerHandles[address].first);
     }
     GEODE_UNWRAP_INTO(auto handle, tulip::hook::createHandler(address, metadata));
     m_handlerHandles[address].first = handle;
-    m_handlerHandles[address].second = 1;
+    m_handlerHandles[address].second = hookCount;
     return Ok(handle);
 }
 
@@ -13,6 +13,7 @@
 #include "ModImpl.hpp"
 #include <internal/crashlog.hpp>
 #include <mutex>
+#include <map>
 #include <optional>
 #include <thread>
 #include <unordered_map>
@@ -34,7 +35,11 @@ namespace geode {
         std::vector<std::filesystem::path> m_modSearchDirectories;
         std::vector<LoadProblem> m_problems;
         std::unordered_map<std::string, Mod*> m_mods;
-        std::deque<Mod*> m_modsToLoad;
+        // mods grouped by dependency level; a mod only depends on mods in earlier levels
+        std::vector<std::vector<Mod*>> m_modLoadLevels;
+        std::unordered_set<Mod*> m_earlyLoadMods;
+        // levels of non-early mods that haven't been loaded yet
+        std::deque<std::vector<Mod*>> m_modsToLoad;
         std::vector<std::filesystem::path> m_texturePaths;
         bool m_isSetup = false;
 
@@ -71,7 +76,7 @@ namespace geode {
         std::unordered_map<void*, std::pair<tulip::hook::HandlerHandle, size_t>> m_handlerHandles;
 
         Result<tulip::hook::HandlerHandle> getHandler(void* address);
-        Result<tulip::hook::HandlerHandle> getOrCreateHandler(void* address, tulip::hook::HandlerMetadata const& metadata);
+        Result<tulip::hook::HandlerHandle> getOrCreateHandler(void* address, tulip::hook::HandlerMetadata const& metadata, size_t hookCount = 1);
         Result<tulip::hook::HandlerHandle> getAndDecreaseHandler(void* address);
         Result<> removeHandlerIfNeeded(void* address);
 
@@ -90,7 +95,21 @@ namespace geode {
         Result<> setup();
         void forceReset();
 
+        std::mutex m_dataWriteMutex;
+        std::condition_variable m_dataWriteCV;
+        std::map<std::filesystem::path, std::string> m_pendingDataWrites;
+        bool m_dataWriteInProgress = false;
+        bool m_dataWriterStarted = false;
+
+        // Serializes changed mod data and writes it before returning
         void saveData();
+        // Serializes changed mod data and leaves writing it to a background thread
+        void saveDataAsync();
+        void queueDataWrites(std::vector<std::pair<std::filesystem::path, std::string>>&& writes);
+        // Writes everything that's still queued on the calling thread
+        void flushDataWrites();
+        // Called once right before the game process exits
+        void shutdown();
         void loadData();
 
         VersionInfo getVersion();
@@ -102,7 +121,11 @@ namespace geode {
         void populateModList(std::vector<ModMetadata>& modQueue);
         void buildModGraph();
         void orderModStack();
+        bool prepareModLoad(Mod* node, bool early);
+        Result<> unzipMod(Mod* node);
+        void loadModBinary(Mod* node);
         void loadModGraph(Mod* node, bool early);
+        void loadModLevel(std::vector<Mod*> const& level);
         void findProblems();
         void refreshModGraph();
         void continueRefreshModGraph();
@@ -129,6 +152,9 @@ namespace geode {
 
         bool isReadyToHook() const;
         void addUninitializedHook(Hook* hook, Mod* mod);
+        bool enableUninitializedHooks();
+        void removeUninitializedHooks(Mod* mod);
+        void removeUninitializedHook(Hook* hook);
 
         Mod* getInternalMod();
         Result<> setupInternalMod();
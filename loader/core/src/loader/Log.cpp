@@ -290,7 +290,9 @@ std::mutex& getLogMutex() {
 }
 
 Severity Logger::getConsoleLogLevel() {
-    const std::string level = Mod::get()->getSettingValue<std::string>("console-log-level");
+    // this is read for every log, so avoid looking the setting up each time
+    static auto handle = Mod::get()->getSettingHandle<std::string>("console-log-level");
+    const std::string level = handle.get();
     if (level == "debug") {
         return Severity::Debug;
     } else if (level == "info") {
@@ -305,7 +307,8 @@ Severity Logger::getConsoleLogLevel() {
 }
 
 Severity Logger::getFileLogLevel() {
-    const std::string level = Mod::get()->getSettingValue<std::string>("file-log-level");
+    static auto handle = Mod::get()->getSettingHandle<std::string>("file-log-level");
+    const std::string level = handle.get();
     if (level == "debug") {
         return Severity::Debug;
     } else if (level == "info") {
@@ -42,10 +42,21 @@ VersionInfo Mod::getVersion() const {
 }
 
 matjson::Value& Mod::getSaveContainer() {
+    m_impl->markDataExposed();
+    return m_impl->getSaveContainer();
+}
+
+matjson::Value const& Mod::getSaveContainer() const {
+    return m_impl->getSaveContainer();
+}
+
+matjson::Value& Mod::getSaveContainerForWrite() {
+    m_impl->markDataDirty();
     return m_impl->getSaveContainer();
 }
 
 matjson::Value& Mod::getSavedSettingsData() {
+    m_impl->markDataExposed();
     return m_impl->m_settings->getSaveData();
 }
 
@@ -195,6 +206,10 @@ std::vector<Hook*> Mod::getHooks() const {
     return m_impl->getHooks();
 }
 
+Result<std::vector<Patch*>> Mod::patchAll(std::vector<std::pair<void*, ByteVector>> const& patches) {
+    return m_impl->patchAll(patches);
+}
+
 Result<Patch*> Mod::claimPatch(std::shared_ptr<Patch> patch) {
     return m_impl->claimPatch(patch);
 }
@@ -256,7 +271,7 @@ void Mod::setLoggingEnabled(bool enabled) {
 }
 
 bool Mod::hasSavedValue(std::string_view key) {
-    return this->getSaveContainer().contains(key);
+    return std::as_const(*this).getSaveContainer().contains(key);
 }
 
 bool Mod::hasLoadProblems() const {
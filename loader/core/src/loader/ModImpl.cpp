@@ -4,6 +4,7 @@
 #include "HookImpl.hpp"
 #include "PatchImpl.hpp"
 #include <internal/about.hpp>
+#include <internal/tracing.hpp>
 #include "console.hpp"
 
 #include <Geode/utils/hash.hpp>
@@ -143,6 +144,14 @@ matjson::Value& Mod::Impl::getSaveContainer() {
     return m_saved;
 }
 
+void Mod::Impl::markDataDirty() {
+    m_dataDirty = true;
+}
+
+void Mod::Impl::markDataExposed() {
+    m_dataExposed = true;
+}
+
 bool Mod::Impl::isEnabled() const {
     return m_enabled || this->isInternal();
 }
@@ -202,30 +211,49 @@ Result<> Mod::Impl::loadData() {
         }
     }
 
+    // nothing needs to be written until something changes, unless one of the
+    // files is missing
+    m_dataDirty = !std::filesystem::exists(settingPath) || !std::filesystem::exists(savedPath);
+    m_savedSettingsSnapshot = std::filesystem::exists(settingPath) ? m_settings->save().dump() : "";
+    m_savedValuesSnapshot = std::filesystem::exists(savedPath) ? m_saved.dump() : "";
+
     return Ok();
 }
 
-Result<> Mod::Impl::saveData() {
+std::vector<std::pair<std::filesystem::path, std::string>> Mod::Impl::serializeData() {
     if (this->getRequestedAction() == ModRequestedAction::UninstallWithSaveData) {
         // Don't save data if the mod is being uninstalled with save data
-        return Ok();
+        return {};
     }
 
-    // ModSettingsManager keeps track of the whole savedata
-    matjson::Value json = m_settings->save();
-
+    // Mods commonly update their saved values in response to this, so it has
+    // to be posted before checking whether anything changed.
     // saveData is expected to be synchronous, and always called from GD thread
     ModStateEvent(m_self, ModEventType::DataSaved).post();
 
-    auto res = utils::file::writeString(m_saveDirPath / "settings.json", json.dump());
-    if (!res) {
-        log::error("Unable to save settings: {}", res.unwrapErr());
+    if (!m_dataDirty && !m_dataExposed) {
+        return {};
     }
-    auto res2 = utils::file::writeString(m_saveDirPath / "saved.json", m_saved.dump());
-    if (!res2) {
-        log::error("Unable to save values: {}", res2.unwrapErr());
+    m_dataDirty = false;
+
+    // ModSettingsManager keeps track of the whole savedata
+    std::vector<std::pair<std::filesystem::path, std::string>> writes;
+    auto settings = m_settings->save().dump();
+    if (settings != m_savedSettingsSnapshot) {
+        m_savedSettingsSnapshot = settings;
+        writes.push_back({ m_saveDirPath / "settings.json", std::move(settings) });
+    }
+    auto saved = m_saved.dump();
+    if (saved != m_savedValuesSnapshot) {
+        m_savedValuesSnapshot = saved;
+        writes.push_back({ m_saveDirPath / "saved.json", std::move(saved) });
     }
+    return writes;
+}
 
+Result<> Mod::Impl::saveData() {
+    LoaderImpl::get()->queueDataWrites(this->serializeData());
+    LoaderImpl::get()->flushDataWrites();
     return Ok();
 }
 
@@ -305,20 +333,31 @@ Result<> Mod::Impl::loadBinary() {
 
     m_enabled = true;
     m_isCurrentlyLoading = true;
-    auto res = this->loadPlatformBinary();
+    auto res = [&] {
+        tracing::Span span("Load binary", "mods", m_metadata.getID());
+        return this->loadPlatformBinary();
+    }();
     if (!res) {
         m_isCurrentlyLoading = false;
         m_enabled = false;
         // make sure to free up the next mod mutex
         LoaderImpl::get()->releaseNextMod();
+        LoaderImpl::get()->removeUninitializedHooks(m_self);
         log::error("Failed to load binary for mod {}: {}", m_metadata.getID(), res.unwrapErr());
         return res;
     }
 
     LoaderImpl::get()->releaseNextMod();
 
-    ModStateEvent(m_self, ModEventType::Loaded).post();
-    ModStateEvent(m_self, ModEventType::DataLoaded).post();
+    if (LoaderImpl::get()->isReadyToHook()) {
+        LoaderImpl::get()->enableUninitializedHooks();
+    }
+
+    {
+        tracing::Span span("Post loaded events", "mods", m_metadata.getID());
+        ModStateEvent(m_self, ModEventType::Loaded).post();
+        ModStateEvent(m_self, ModEventType::DataLoaded).post();
+    }
 
     // do we not have a function for getting all the dependencies of a mod directly? ok then
     // Anyway this lets all of this mod's dependencies know it has been loaded
@@ -331,6 +370,12 @@ Result<> Mod::Impl::loadBinary() {
 
     m_isCurrentlyLoading = false;
 
+    // Hooks claimed by the listeners of the events above were queued too, 
+    // and nothing else would enable them if this is the last mod to load
+    if (LoaderImpl::get()->isReadyToHook()) {
+        LoaderImpl::get()->enableUninitializedHooks();
+    }
+
     return Ok();
 }
 
@@ -393,7 +438,7 @@ Result<> Mod::Impl::uninstall(bool deleteSaveData) {
         ModRequestedAction::Uninstall;
 
     // Make loader forget the mod should be disabled
-    Mod::get()->getSaveContainer().erase("should-load-" + m_metadata.getID());
+    Mod::get()->getSaveContainerForWrite().erase("should-load-" + m_metadata.getID());
 
     std::error_code ec;
     std::filesystem::remove(m_metadata.getPath(), ec);
@@ -468,7 +513,9 @@ Result<Hook*> Mod::Impl::claimHook(std::shared_ptr<Hook> hook) {
     if (!this->isEnabled() || !hook->getAutoEnable())
         return Ok(ptr);
 
-    if (!LoaderImpl::get()->isReadyToHook() && hook->getAutoEnable()) {
+    // Hooks claimed while the binary is being loaded are enabled all at once 
+    // after it has finished loading
+    if (!LoaderImpl::get()->isReadyToHook() || m_isCurrentlyLoading) {
         LoaderImpl::get()->addUninitializedHook(ptr, m_self);
         return Ok(ptr);
     }
@@ -500,6 +547,8 @@ Result<> Mod::Impl::disownHook(Hook* hook) {
                    "didn't have the hook in m_hooks.");
 
     m_hooks.erase(foundIt);
+    // the hook may be freed right after this, so it can't stay queued
+    LoaderImpl::get()->removeUninitializedHook(hook);
 
     if (!this->isEnabled() || !hook->getAutoEnable())
         return Ok();
@@ -534,6 +583,34 @@ Result<Patch*> Mod::Impl::claimPatch(std::shared_ptr<Patch> patch) {
     return Ok(ptr);
 }
 
+Result<std::vector<Patch*>> Mod::Impl::patchAll(std::vector<std::pair<void*, ByteVector>> const& patches) {
+    std::vector<std::shared_ptr<Patch>> created;
+    std::vector<Patch::Impl*> impls;
+    created.reserve(patches.size());
+    impls.reserve(patches.size());
+    for (auto const& [address, data] : patches) {
+        auto patch = Patch::create(address, data);
+        impls.push_back(patch->m_impl.get());
+        created.push_back(std::move(patch));
+    }
+
+    if (this->isEnabled()) {
+        auto res = Patch::Impl::enableAll(impls);
+        if (!res) {
+            return Err("Cannot enable patches: {}", res.unwrapErr());
+        }
+    }
+
+    std::vector<Patch*> ret;
+    ret.reserve(created.size());
+    for (auto& patch : created) {
+        (void) patch->m_impl->setOwner(m_self);
+        ret.push_back(patch.get());
+        m_patches.push_back(std::move(patch));
+    }
+    return Ok(ret);
+}
+
 Result<> Mod::Impl::disownPatch(Patch* patch) {
     if (patch->getOwner() != m_self) {
         return Err("Cannot disown patch not owned by this mod");
@@ -48,6 +48,23 @@ namespace geode {
          * Saved values
          */
         matjson::Value m_saved = matjson::Value();
+        /**
+         * Whether settings or saved values have changed since they were last
+         * written to disk
+         */
+        bool m_dataDirty = true;
+        /**
+         * Whether a mutable reference to the saved values or settings data
+         * has been handed out. The mod may change the data through it at any
+         * time, so from then on every save has to check whether it changed
+         */
+        bool m_dataExposed = false;
+        /**
+         * The settings and saved values as they were last written to disk,
+         * to tell whether they have to be written again
+         */
+        std::string m_savedSettingsSnapshot;
+        std::string m_savedValuesSnapshot;
         /**
          * Setting values. This is behind unique_ptr for interior mutability
          */
@@ -97,6 +114,8 @@ namespace geode {
         std::filesystem::path getBinaryPath() const;
 
         matjson::Value& getSaveContainer();
+        void markDataDirty();
+        void markDataExposed();
 
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
         void setMetadata(ModMetadata const& metadata);
@@ -104,6 +123,12 @@ namespace geode {
 #endif
 
         Result<> saveData();
+        /**
+         * Serialize settings and saved values if they've changed since the
+         * last save
+         * @returns The files that should be written, paired with their contents
+         */
+        std::vector<std::pair<std::filesystem::path, std::string>> serializeData();
         Result<> loadData();
 
         std::filesystem::path getSaveDir() const;
@@ -124,6 +149,7 @@ namespace geode {
         Result<> disownHook(Hook* hook);
         [[nodiscard]] std::vector<Hook*> getHooks() const;
 
+        Result<std::vector<Patch*>> patchAll(std::vector<std::pair<void*, ByteVector>> const& patches);
         Result<Patch*> claimPatch(std::shared_ptr<Patch> patch);
         Result<> disownPatch(Patch* patch);
         [[nodiscard]] std::vector<Patch*> getPatches() const;
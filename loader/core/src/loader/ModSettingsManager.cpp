@@ -87,6 +87,8 @@ public:
     }
 };
 
+static std::atomic_size_t SETTINGS_GENERATION = 1;
+
 class ModSettingsManager::Impl final {
 public:
     struct SettingInfo final {
@@ -146,6 +148,7 @@ public:
             if (auto v3 = (*gen)(key, modID, setting.json)) {
                 setting.v3 = v3.unwrap();
                 this->loadSettingValueFromSave(key);
+                SETTINGS_GENERATION += 1;
             }
             else {
                 log::error(
@@ -162,6 +165,10 @@ ModSettingsManager* ModSettingsManager::from(Mod* mod) {
     return ModImpl::getImpl(mod)->m_settings.get();
 }
 
+std::atomic_size_t const& ModSettingsManager::getSettingsGeneration() {
+    return SETTINGS_GENERATION;
+}
+
 ModSettingsManager::ModSettingsManager(ModMetadata const& metadata)
   : m_impl(std::make_unique<Impl>())
 {
@@ -180,7 +187,10 @@ ModSettingsManager::ModSettingsManager(ModMetadata const& metadata)
     }
     m_impl->createSettings();
 }
-ModSettingsManager::~ModSettingsManager() {}
+ModSettingsManager::~ModSettingsManager() {
+    // any handles pointing to our settings need to let go of them
+    SETTINGS_GENERATION += 1;
+}
 ModSettingsManager::ModSettingsManager(ModSettingsManager&&) = default;
 
 void ModSettingsManager::markRestartRequired() {
@@ -24,11 +24,8 @@ Patch::Impl::~Impl() {
 
 // TODO: replace this with a safe one
 static ByteVector readMemory(void* address, size_t amount) {
-    ByteVector ret;
-    for (size_t i = 0; i < amount; i++) {
-        ret.push_back(*reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(address) + i));
-    }
-    return ret;
+    auto const bytes = reinterpret_cast<uint8_t const*>(address);
+    return ByteVector(bytes, bytes + amount);
 }
 
 std::shared_ptr<Patch> Patch::Impl::create(void* address, const geode::ByteVector& patch) {
@@ -40,45 +37,140 @@ std::shared_ptr<Patch> Patch::Impl::create(void* address, const geode::ByteVecto
     });
 }
 
-std::vector<Patch::Impl*>& Patch::Impl::allEnabled() {
-    static std::vector<Patch::Impl*> vec;
-    return vec;
+std::map<uintptr_t, Patch::Impl*>& Patch::Impl::allEnabled() {
+    static std::map<uintptr_t, Patch::Impl*> map;
+    return map;
+}
+
+Patch::Impl* Patch::Impl::findOverlapping(uintptr_t start, size_t size) {
+    if (size == 0) {
+        return nullptr;
+    }
+    auto& enabled = allEnabled();
+    // Since enabled patches don't overlap each other, the only one that can 
+    // overlap this range is the last one that starts before the range ends; 
+    // this also catches patches that fully contain the range or are 
+    // contained by it
+    auto it = enabled.upper_bound(start + size - 1);
+    if (it == enabled.begin()) {
+        return nullptr;
+    }
+    --it;
+    auto other = it->second;
+    if (other->getAddress() + other->m_patch.size() <= start) {
+        return nullptr;
+    }
+    return other;
+}
+
+static std::string describePatch(Patch::Impl* patch) {
+    if (auto owner = patch->getOwner()) {
+        return fmt::format("patch at {} from {}", patch->m_address, owner->getID());
+    }
+    return fmt::format("patch at {}", patch->m_address);
 }
 
 Result<> Patch::Impl::enable() {
-    auto const thisMin = this->getAddress();
-    auto const thisMax = this->getAddress() + this->m_patch.size() - 1;
-    // TODO: this feels slow. can be faster
-    for (const auto& other : allEnabled()) {
-        auto const otherMin = other->getAddress();
-        auto const otherMax = other->getAddress() + other->m_patch.size() - 1;
-        bool intersects = (thisMin >= otherMin && thisMin <= otherMax) || (thisMax >= otherMin && thisMax <= otherMax);
-        if (!intersects)
-            continue;
-        return Err(
-            "Failed to enable patch: overlaps patch at {} from {}",
-            other->m_address, other->getOwner()->getID()
-        );
+    if (m_enabled) {
+        return Ok();
+    }
+    if (auto other = findOverlapping(this->getAddress(), m_patch.size())) {
+        return Err("Failed to enable patch: overlaps {}", describePatch(other));
     }
     auto res = tulip::hook::writeMemory(m_address, m_patch.data(), m_patch.size());
     if (!res) return Err("Failed to enable patch: {}", res.unwrapErr());
     m_enabled = true;
-    allEnabled().push_back(this);
+    if (!m_patch.empty()) {
+        allEnabled().insert({ this->getAddress(), this });
+    }
+    return Ok();
+}
+
+Result<> Patch::Impl::enableAll(std::vector<Patch::Impl*> const& patches) {
+    std::vector<Patch::Impl*> sorted;
+    sorted.reserve(patches.size());
+    for (auto patch : patches) {
+        if (!patch->m_enabled && !patch->m_patch.empty()) {
+            sorted.push_back(patch);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+        return a->getAddress() < b->getAddress();
+    });
+
+    // Check everything up front so nothing gets written if any patch can't 
+    // be enabled; when sorted by address, a patch can only overlap another 
+    // new one if it starts before the furthest end seen so far
+    Patch::Impl* furthest = nullptr;
+    uintptr_t furthestEnd = 0;
+    for (auto patch : sorted) {
+        if (auto other = findOverlapping(patch->getAddress(), patch->m_patch.size())) {
+            return Err("Failed to enable {}: overlaps {}", describePatch(patch), describePatch(other));
+        }
+        if (furthest && patch->getAddress() < furthestEnd) {
+            return Err("Failed to enable {}: overlaps {}", describePatch(patch), describePatch(furthest));
+        }
+        auto const end = patch->getAddress() + patch->m_patch.size();
+        if (end > furthestEnd) {
+            furthest = patch;
+            furthestEnd = end;
+        }
+    }
+
+    // Write runs of patches that are next to each other in one go, so each 
+    // run only changes memory protection once
+    struct Run {
+        uintptr_t start;
+        ByteVector bytes;
+        ByteVector original;
+    };
+    std::vector<Run> runs;
+    for (auto patch : sorted) {
+        if (runs.empty() || runs.back().start + runs.back().bytes.size() != patch->getAddress()) {
+            runs.push_back({ patch->getAddress(), {}, {} });
+        }
+        auto& run = runs.back();
+        run.bytes.insert(run.bytes.end(), patch->m_patch.begin(), patch->m_patch.end());
+        run.original.insert(run.original.end(), patch->m_original.begin(), patch->m_original.end());
+    }
+    for (size_t i = 0; i < runs.size(); i++) {
+        auto& run = runs[i];
+        auto res = tulip::hook::writeMemory(reinterpret_cast<void*>(run.start), run.bytes.data(), run.bytes.size());
+        if (!res) {
+            // Undo the runs that were already written
+            for (size_t j = 0; j < i; j++) {
+                (void) tulip::hook::writeMemory(
+                    reinterpret_cast<void*>(runs[j].start), runs[j].original.data(), runs[j].original.size()
+                );
+            }
+            return Err("Failed to enable patches: {}", res.unwrapErr());
+        }
+    }
+
+    for (auto patch : sorted) {
+        patch->m_enabled = true;
+        allEnabled().insert({ patch->getAddress(), patch });
+    }
+    // Empty patches don't write anything but should still count as enabled
+    for (auto patch : patches) {
+        patch->m_enabled = true;
+    }
     return Ok();
 }
 
 Result<> Patch::Impl::disable() {
+    if (!m_enabled) {
+        return Err("Failed to disable patch: patch is already disabled");
+    }
+
     auto res = tulip::hook::writeMemory(m_address, m_original.data(), m_original.size());
     if (!res) return Err("Failed to disable patch: {}", res.unwrapErr());
 
     m_enabled = false;
-    auto it = std::find(allEnabled().begin(), allEnabled().end(), this);
-
-    if (it == allEnabled().end()) {
-        return Err("Failed to disable patch: patch is already disabled");
+    auto it = allEnabled().find(this->getAddress());
+    if (it != allEnabled().end() && it->second == this) {
+        allEnabled().erase(it);
     }
-
-    allEnabled().erase(it);
     return Ok();
 }
 
@@ -87,11 +179,19 @@ ByteVector const& Patch::Impl::getBytes() const {
 }
 
 Result<> Patch::Impl::updateBytes(const ByteVector& bytes) {
-    m_patch = bytes;
-
-    if (m_enabled) {
+    bool const wasEnabled = m_enabled;
+    if (wasEnabled) {
         auto res = this->disable();
         if (!res) return Err("Failed to update patch: {}", res.unwrapErr());
+    }
+
+    // The original bytes have to cover the new patch if its size changed
+    m_patch = bytes;
+    if (m_original.size() != m_patch.size()) {
+        m_original = readMemory(m_address, m_patch.size());
+    }
+
+    if (wasEnabled) {
         auto res2 = this->enable();
         if (!res2) return Err("Failed to update patch: {}", res2.unwrapErr());
     }
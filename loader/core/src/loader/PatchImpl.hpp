@@ -6,6 +6,8 @@
 #include "ModImpl.hpp"
 #include "ModPatch.hpp"
 
+#include <map>
+
 using namespace geode::prelude;
 
 class Patch::Impl final : ModPatch {
@@ -14,7 +16,24 @@ public:
     ~Impl();
 
     static std::shared_ptr<Patch> create(void* address, const ByteVector& patch);
-    static std::vector<Patch::Impl*>& allEnabled();
+    /**
+     * All enabled patches keyed by their start address. Enabled patches never 
+     * overlap, so this is also sorted by end address
+     */
+    static std::map<uintptr_t, Patch::Impl*>& allEnabled();
+    /**
+     * Find an enabled patch that overlaps the range [start, start + size)
+     * @returns The overlapping patch, or null if there is none
+     */
+    static Patch::Impl* findOverlapping(uintptr_t start, size_t size);
+
+    /**
+     * Enable many patches at once. Overlaps are checked for every patch 
+     * before anything is written, and patches that are next to each other 
+     * in memory are written together. Either every patch is enabled or none 
+     * of them are
+     */
+    static Result<> enableAll(std::vector<Patch::Impl*> const& patches);
 
     Patch* m_self = nullptr;
     void* m_address;
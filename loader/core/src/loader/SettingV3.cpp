@@ -8,6 +8,7 @@
 #include <regex>
 // #include "SettingNodeV3.hpp"
 #include <matjson/std.hpp>
+#include "ModImpl.hpp"
 
 using namespace geode::prelude;
 
@@ -614,7 +615,11 @@ Mod* SettingV3::getMod() const {
 }
 
 void SettingV3::markChanged() {
-    auto manager = ModSettingsManager::from(this->getMod());
+    auto mod = this->getMod();
+    auto manager = ModSettingsManager::from(mod);
+    if (mod) {
+        ModImpl::getImpl(mod)->markDataDirty();
+    }
     if (m_impl->requiresRestart) {
         manager->markRestartRequired();
     }
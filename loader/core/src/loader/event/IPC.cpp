@@ -1,7 +1,12 @@
 #include <Geode/loader/event/IPC.hpp>
 #include "IPC.hpp"
 #include <matjson.hpp>
+#include <Geode/loader/Loader.hpp>
 #include <Geode/loader/Mod.hpp>
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <mutex>
 
 using namespace geode::prelude;
 
@@ -17,8 +22,35 @@ ipc::IPCEvent::IPCEvent(
     replyData(replyData),
     messageData(std::make_unique<matjson::Value>(messageData)) {}
 
+ipc::IPCEvent::IPCEvent(
+    void* rawPipeHandle,
+    std::string const& targetModID,
+    std::string const& messageID,
+    matjson::Value&& messageData,
+    std::span<uint8_t const> attachment,
+    std::function<std::span<uint8_t>(size_t)> replyAttachmentWriter,
+    matjson::Value& replyData
+) : m_rawPipeHandle(rawPipeHandle),
+    targetModID(targetModID),
+    messageID(messageID),
+    replyData(replyData),
+    messageData(std::make_unique<matjson::Value>(std::move(messageData))),
+    m_attachment(attachment),
+    m_replyAttachmentWriter(std::move(replyAttachmentWriter)) {}
+
 ipc::IPCEvent::~IPCEvent() {}
 
+std::span<uint8_t const> ipc::IPCEvent::getAttachment() const {
+    return m_attachment;
+}
+
+std::span<uint8_t> ipc::IPCEvent::writeReplyAttachment(size_t size) {
+    if (!m_replyAttachmentWriter) {
+        return {};
+    }
+    return m_replyAttachmentWriter(size);
+}
+
 ListenerResult ipc::IPCFilter::handle(std::function<Callback> fn, IPCEvent* event) {
     if (event->targetModID == m_modID && event->messageID == m_messageID) {
         event->replyData = fn(event);
@@ -30,36 +62,282 @@ ListenerResult ipc::IPCFilter::handle(std::function<Callback> fn, IPCEvent* even
 ipc::IPCFilter::IPCFilter(std::string const& modID, std::string const& messageID) :
     m_modID(modID), m_messageID(messageID) {}
 
-matjson::Value ipc::processRaw(void* rawHandle, std::string const& buffer) {
+// Must be called on the main thread
+static Result<matjson::Value> handleMessage(
+    void* rawHandle, matjson::Value&& json, std::span<uint8_t const> attachment,
+    std::function<std::span<uint8_t>(size_t)> replyAttachmentWriter
+) {
+    if (!json.contains("mod") || !json["mod"].isString()) {
+        return Err("Received IPC message without 'mod' field");
+    }
+    if (!json.contains("message") || !json["message"].isString()) {
+        return Err("Received IPC message without 'message' field");
+    }
+    matjson::Value data;
+    if (json.contains("data")) {
+        data = std::move(json["data"]);
+    }
     matjson::Value reply;
+    IPCEvent(
+        rawHandle, json["mod"].asString().unwrap(), json["message"].asString().unwrap(),
+        std::move(data), attachment, std::move(replyAttachmentWriter), reply
+    ).post();
+    return Ok(std::move(reply));
+}
 
+matjson::Value ipc::processRaw(void* rawHandle, std::string const& buffer) {
     auto res = matjson::Value::parse(buffer);
     if (!res) {
         log::warn("Received IPC message that isn't valid JSON: {}", res.unwrapErr());
-        return reply;
+        return matjson::Value();
     }
-    matjson::Value json = res.unwrap();
 
-    if (!json.contains("mod") || !json["mod"].isString()) {
-        log::warn("Received IPC message without 'mod' field");
-        return reply;
+    // listeners expect to be called on the main thread like every other event
+    auto promise = std::make_shared<std::promise<matjson::Value>>();
+    auto future = promise->get_future();
+    Loader::get()->queueInMainThread([rawHandle, promise, json = res.unwrap()]() mutable {
+        auto reply = handleMessage(rawHandle, std::move(json), {}, nullptr);
+        if (!reply) {
+            log::warn("{}", reply.unwrapErr());
+        }
+        promise->set_value(reply.unwrapOr(matjson::Value()));
+    });
+    return future.get();
+}
+
+// Reading frames straight into their own buffer only makes sense for ones
+// larger than a regular read
+static constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+
+static void writeUInt32(char* dest, uint32_t value) {
+    dest[0] = static_cast<char>(value & 0xff);
+    dest[1] = static_cast<char>((value >> 8) & 0xff);
+    dest[2] = static_cast<char>((value >> 16) & 0xff);
+    dest[3] = static_cast<char>((value >> 24) & 0xff);
+}
+
+static uint32_t readUInt32(char const* src) {
+    auto bytes = reinterpret_cast<uint8_t const*>(src);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+void ipc::appendFrame(std::string& out, std::string_view payload) {
+    char header[FRAME_HEADER_SIZE];
+    writeUInt32(header, static_cast<uint32_t>(payload.size()));
+    out.append(header, FRAME_HEADER_SIZE);
+    out.append(payload);
+}
+
+std::string_view ipc::Frame::payload() const {
+    return std::string_view(buffer).substr(offset, size);
+}
+
+Result<std::pair<std::string_view, std::span<uint8_t const>>> ipc::Frame::split() const {
+    auto payload = this->payload();
+    if (!hasAttachment) {
+        return Ok(std::make_pair(payload, std::span<uint8_t const>()));
     }
-    if (!json.contains("message") || !json["message"].isString()) {
-        log::warn("Received IPC message without 'message' field");
-        return reply;
+    if (payload.size() < sizeof(uint32_t)) {
+        return Err("Frame is too small to have an attachment");
     }
-    matjson::Value data;
-    if (json.contains("data")) {
-        data = json["data"];
+    size_t attachmentSize = readUInt32(payload.data());
+    if (payload.size() - sizeof(uint32_t) < attachmentSize) {
+        return Err("Attachment of {} bytes doesn't fit in its frame", attachmentSize);
+    }
+    auto attachment = std::span(
+        reinterpret_cast<uint8_t const*>(payload.data() + sizeof(uint32_t)), attachmentSize
+    );
+    return Ok(std::make_pair(payload.substr(sizeof(uint32_t) + attachmentSize), attachment));
+}
+
+std::optional<uint32_t> ipc::FrameReader::peekHeader() const {
+    if (m_size - m_offset < FRAME_HEADER_SIZE) {
+        return std::nullopt;
+    }
+    return readUInt32(m_buffer.data() + m_offset);
+}
+
+std::span<char> ipc::FrameReader::prepare() {
+    size_t wanted = READ_CHUNK_SIZE;
+    auto header = this->peekHeader();
+    if (header) {
+        auto frameSize = FRAME_HEADER_SIZE + (*header & ~FRAME_ATTACHMENT_FLAG);
+        if (frameSize - (m_size - m_offset) > READ_CHUNK_SIZE && frameSize <= FRAME_HEADER_SIZE + MAX_FRAME_SIZE) {
+            // receive exactly the rest of the frame, so the buffer holds
+            // only it and can be handed off without copying
+            wanted = frameSize - (m_size - m_offset);
+        }
+    }
+    if (m_offset > 0 && (m_offset >= m_size / 2 || wanted > READ_CHUNK_SIZE)) {
+        m_buffer.erase(0, m_offset);
+        m_size -= m_offset;
+        m_offset = 0;
+    }
+    if (m_buffer.size() < m_size + wanted) {
+        m_buffer.resize(m_size + wanted);
+    }
+    return std::span(m_buffer.data() + m_size, wanted);
+}
+
+void ipc::FrameReader::commit(size_t size) {
+    m_size += size;
+}
+
+Result<std::optional<ipc::Frame>> ipc::FrameReader::next() {
+    auto header = this->peekHeader();
+    if (!header) {
+        return Ok(std::nullopt);
+    }
+    size_t size = *header & ~FRAME_ATTACHMENT_FLAG;
+    if (size > MAX_FRAME_SIZE) {
+        return Err("Frame of {} bytes is larger than the maximum of {} bytes", size, MAX_FRAME_SIZE);
+    }
+    if (m_size - m_offset - FRAME_HEADER_SIZE < size) {
+        return Ok(std::nullopt);
+    }
+
+    Frame frame;
+    frame.size = size;
+    frame.hasAttachment = *header & FRAME_ATTACHMENT_FLAG;
+    if (m_offset == 0 && m_size == FRAME_HEADER_SIZE + size && size > READ_CHUNK_SIZE) {
+        // the buffer holds exactly this frame, so hand it off as is
+        m_buffer.resize(m_size);
+        frame.buffer = std::move(m_buffer);
+        frame.offset = FRAME_HEADER_SIZE;
+        m_buffer = std::string();
+        m_size = 0;
+        return Ok(std::move(frame));
+    }
+    frame.buffer = m_buffer.substr(m_offset + FRAME_HEADER_SIZE, size);
+    m_offset += FRAME_HEADER_SIZE + size;
+    if (m_offset == m_size) {
+        m_size = 0;
+        m_offset = 0;
+    }
+    return Ok(std::move(frame));
+}
+
+namespace {
+    struct PendingRequest {
+        std::shared_ptr<ipc::Connection> connection;
+        ipc::Frame frame;
+    };
+
+    std::mutex s_pendingMutex;
+    std::deque<PendingRequest> s_pending;
+    // Whether handling the pending requests has already been queued in the main thread
+    bool s_dispatchQueued = false;
+
+    // Handle a request and append its reply frame to out
+    void handleFramedRequest(ipc::Connection* connection, ipc::Frame const& frame, std::string& out) {
+        auto const frameStart = out.size();
+        out.append(ipc::FRAME_HEADER_SIZE, '\0');
+
+        // the reply's attachment is written in place, right after its header
+        bool hasReplyAttachment = false;
+        auto const writeAttachment = [&](size_t size) -> std::span<uint8_t> {
+            if (hasReplyAttachment || size > ipc::MAX_FRAME_SIZE / 2) {
+                return {};
+            }
+            hasReplyAttachment = true;
+            auto start = out.size();
+            out.resize(start + sizeof(uint32_t) + size);
+            writeUInt32(out.data() + start, static_cast<uint32_t>(size));
+            return std::span(reinterpret_cast<uint8_t*>(out.data() + start + sizeof(uint32_t)), size);
+        };
+
+        auto reply = matjson::makeObject({});
+        auto const handle = [&]() -> Result<> {
+            GEODE_UNWRAP_INTO(auto parts, frame.split());
+            auto [envelope, attachment] = parts;
+            GEODE_UNWRAP_INTO(auto message, matjson::parse(envelope).mapErr([](auto const& err) {
+                return fmt::format("Message isn't valid JSON: {}", err);
+            }));
+            // requests are told apart by their ID, so many can be in flight at once
+            if (message.contains("id")) {
+                reply["id"] = message["id"];
+            }
+            GEODE_UNWRAP_INTO(
+                reply["reply"],
+                handleMessage(connection, std::move(message), attachment, writeAttachment)
+            );
+            return Ok();
+        };
+        if (auto res = handle(); !res) {
+            reply["error"] = res.unwrapErr();
+        }
+
+        out += reply.dump(matjson::NO_INDENTATION);
+        uint32_t header = static_cast<uint32_t>(out.size() - frameStart - ipc::FRAME_HEADER_SIZE);
+        if (hasReplyAttachment) {
+            header |= ipc::FRAME_ATTACHMENT_FLAG;
+        }
+        writeUInt32(out.data() + frameStart, header);
+    }
+
+    void dispatchPending() {
+        std::vector<PendingRequest> pending;
+        {
+            std::lock_guard lock(s_pendingMutex);
+            auto count = std::min(s_pending.size(), ipc::MAX_REQUESTS_PER_PASS);
+            pending.assign(
+                std::make_move_iterator(s_pending.begin()),
+                std::make_move_iterator(s_pending.begin() + count)
+            );
+            s_pending.erase(s_pending.begin(), s_pending.begin() + count);
+            // the rest are handled next frame
+            if (s_pending.empty()) {
+                s_dispatchQueued = false;
+            }
+            else {
+                Loader::get()->queueInMainThread(&dispatchPending);
+            }
+        }
+
+        // every connection gets all of its replies from this batch at once
+        struct Replies {
+            std::shared_ptr<ipc::Connection> connection;
+            std::string frames;
+            size_t count = 0;
+        };
+        std::vector<Replies> replies;
+        for (auto& request : pending) {
+            auto it = std::find_if(replies.begin(), replies.end(), [&](auto const& entry) {
+                return entry.connection == request.connection;
+            });
+            if (it == replies.end()) {
+                replies.push_back({ request.connection });
+                it = std::prev(replies.end());
+            }
+            handleFramedRequest(request.connection.get(), request.frame, it->frames);
+            it->count += 1;
+        }
+        for (auto& [connection, frames, count] : replies) {
+            // sending wakes up the transport, which may read more requests
+            // now that these are done
+            connection->pendingRequests -= count;
+            connection->sendFrames(std::move(frames));
+        }
+    }
+}
+
+void ipc::queueRequests(std::shared_ptr<Connection> connection, std::vector<Frame> frames) {
+    if (frames.empty()) {
+        return;
+    }
+    connection->pendingRequests += frames.size();
+    std::lock_guard lock(s_pendingMutex);
+    for (auto& frame : frames) {
+        s_pending.push_back({ connection, std::move(frame) });
+    }
+    if (!s_dispatchQueued) {
+        s_dispatchQueued = true;
+        Loader::get()->queueInMainThread(&dispatchPending);
     }
-    // log::debug("Posting IPC event");
-    // ! warning: if the event system is ever made asynchronous this will break!
-    IPCEvent(rawHandle, json["mod"].asString().unwrap(), json["message"].asString().unwrap(), data, reply).post();
-    return reply;
 }
 
 void ipc::listen(std::string const& messageID, matjson::Value(*callback)(IPCEvent*)) {
     (void) new EventListener(
         callback, IPCFilter(getMod()->getID(), messageID)
     );
-}
\ No newline at end of file
+}
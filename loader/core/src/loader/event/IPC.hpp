@@ -1,9 +1,109 @@
 ﻿#pragma once
 
+#include <Geode/Result.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <matjson.hpp>
 
 namespace geode::ipc {
     void setup();
+    /**
+     * Handle a single unframed message and wait for its reply. The message
+     * is handled on the main thread, so this must not be called from it
+     */
     matjson::Value processRaw(void* rawHandle, std::string const& buffer);
+
+    // Framed messages start with their payload's size as a 32-bit little
+    // endian integer, so many of them can be sent over one connection
+    constexpr size_t FRAME_HEADER_SIZE = sizeof(uint32_t);
+    constexpr size_t MAX_FRAME_SIZE = 64 * 1024 * 1024;
+    // Set in the header of frames whose payload starts with a binary
+    // attachment (its size, then its data) before the JSON
+    constexpr uint32_t FRAME_ATTACHMENT_FLAG = 0x80000000;
+
+    void appendFrame(std::string& out, std::string_view payload);
+
+    /**
+     * A frame's payload, along with the buffer it was received into
+     */
+    struct Frame {
+        std::string buffer;
+        size_t offset = 0;
+        size_t size = 0;
+        bool hasAttachment = false;
+
+        std::string_view payload() const;
+        /**
+         * Split the payload into its JSON and its attachment, which point
+         * into the frame's buffer
+         */
+        Result<std::pair<std::string_view, std::span<uint8_t const>>> split() const;
+    };
+
+    /**
+     * Splits a stream of bytes back into frames, however it was chunked
+     */
+    class FrameReader final {
+    private:
+        std::string m_buffer;
+        // Bytes of m_buffer that have been received
+        size_t m_size = 0;
+        // Start of the first frame that hasn't been read yet
+        size_t m_offset = 0;
+
+        std::optional<uint32_t> peekHeader() const;
+
+    public:
+        /**
+         * Get space to receive the next bytes of the stream into, and then
+         * commit however many were received. Large frames are received
+         * directly into the buffer they're handed off in
+         */
+        std::span<char> prepare();
+        void commit(size_t size);
+        /**
+         * Get the next complete frame, if one has been read
+         * @returns An error if the frame is larger than MAX_FRAME_SIZE, in
+         * which case the stream can't be read further
+         */
+        Result<std::optional<Frame>> next();
+    };
+
+    // Transports stop reading requests from a connection once this many of
+    // them are waiting to be handled (give or take the ones that arrived in
+    // the same read)
+    constexpr size_t MAX_PENDING_REQUESTS = 1024;
+    // Requests handled in one main thread pass; the rest wait for the next
+    // one, so a flood of requests can't stall a frame
+    constexpr size_t MAX_REQUESTS_PER_PASS = 256;
+
+    /**
+     * A client connected through one of the transports
+     */
+    class Connection {
+    public:
+        // Requests that have been queued but not replied to yet
+        std::atomic_size_t pendingRequests = 0;
+
+        virtual ~Connection() = default;
+        /**
+         * Send the reply frames for a batch of this connection's requests.
+         * Called on the main thread, so this should only hand the data off
+         * to the transport
+         */
+        virtual void sendFrames(std::string frames) = 0;
+    };
+
+    /**
+     * Queue framed requests to be handled on the main thread. Each request's
+     * reply is framed and sent back with the replies to every other request
+     * of the connection that was handled in the same batch
+     */
+    void queueRequests(std::shared_ptr<Connection> connection, std::vector<Frame> frames);
 }
@@ -0,0 +1,358 @@
+#include <Geode/platform/cplatform.h>
+
+#if defined(GEODE_IS_ANDROID) || defined(GEODE_IS_MACOS)
+
+#include <Geode/loader/event/IPC.hpp>
+#include "IPC.hpp"
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/general.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace geode::prelude;
+
+// Clients that don't read their replies stop having their requests read
+// once this much is waiting to be sent to them
+static constexpr size_t MAX_BUFFERED_REPLIES = 16 * 1024 * 1024;
+
+#ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int SEND_FLAGS = 0;
+#endif
+
+#ifdef GEODE_IS_ANDROID
+// The abstract socket namespace has no permissions, so any installed app could
+// connect; only the game itself and adb's shell user are let through
+static constexpr uid_t SHELL_UID = 2000;
+
+static bool isPeerAllowed(int fd) {
+    ucred credentials {};
+    socklen_t size = sizeof(credentials);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0) {
+        return false;
+    }
+    return credentials.uid == getuid() || credentials.uid == SHELL_UID;
+}
+#endif
+
+static bool setNonBlocking(int fd) {
+    auto flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 &&
+        fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+}
+
+namespace {
+    class UnixSocketConnection final : public ipc::Connection {
+    public:
+        int const fd;
+        int const wakeup;
+        // Only used by the IPC thread
+        ipc::FrameReader reader;
+
+        std::mutex mutex;
+        std::string outgoing;
+        size_t sent = 0;
+        bool closed = false;
+
+        UnixSocketConnection(int fd, int wakeup) : fd(fd), wakeup(wakeup) {}
+
+        void sendFrames(std::string frames) override {
+            {
+                std::lock_guard lock(mutex);
+                if (closed) {
+                    return;
+                }
+                if (outgoing.empty()) {
+                    outgoing = std::move(frames);
+                }
+                else {
+                    outgoing += frames;
+                }
+            }
+            // let the IPC thread know there's something to send
+            char byte = 0;
+            (void)write(wakeup, &byte, 1);
+        }
+
+        size_t pendingSize() {
+            std::lock_guard lock(mutex);
+            return outgoing.size() - sent;
+        }
+
+        // Returns false if the connection was closed
+        bool flush() {
+            std::lock_guard lock(mutex);
+            while (sent < outgoing.size()) {
+                auto count = send(fd, outgoing.data() + sent, outgoing.size() - sent, SEND_FLAGS);
+                if (count < 0) {
+                    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+                }
+                sent += count;
+            }
+            outgoing.clear();
+            sent = 0;
+            return true;
+        }
+
+        enum class ReceiveResult {
+            Received,
+            // Everything that has been sent has been received
+            Drained,
+            Closed,
+        };
+
+        ReceiveResult receive() {
+            while (true) {
+                auto buffer = reader.prepare();
+                auto count = recv(fd, buffer.data(), buffer.size(), 0);
+                if (count == 0) {
+                    return ReceiveResult::Closed;
+                }
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return errno == EAGAIN || errno == EWOULDBLOCK ?
+                        ReceiveResult::Drained : ReceiveResult::Closed;
+                }
+                reader.commit(count);
+                return count < static_cast<ssize_t>(buffer.size()) ?
+                    ReceiveResult::Drained : ReceiveResult::Received;
+            }
+        }
+
+        void close() {
+            std::lock_guard lock(mutex);
+            closed = true;
+            outgoing.clear();
+            ::close(fd);
+        }
+    };
+
+    class UnixSocketServer final {
+    private:
+        int m_listener = -1;
+        int m_wakeupRead = -1;
+        int m_wakeupWrite = -1;
+        std::vector<std::shared_ptr<UnixSocketConnection>> m_connections;
+
+        void accept() {
+            while (true) {
+                auto fd = ::accept(m_listener, nullptr, nullptr);
+                if (fd < 0) {
+                    return;
+                }
+                if (!setNonBlocking(fd)) {
+                    ::close(fd);
+                    continue;
+                }
+            #ifdef GEODE_IS_ANDROID
+                if (!isPeerAllowed(fd)) {
+                    log::warn("Refused an IPC connection from another app");
+                    ::close(fd);
+                    continue;
+                }
+            #endif
+            #ifdef SO_NOSIGPIPE
+                int one = 1;
+                setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+            #endif
+                m_connections.push_back(std::make_shared<UnixSocketConnection>(fd, m_wakeupWrite));
+            }
+        }
+
+        // Returns false if the connection should be closed
+        bool read(std::shared_ptr<UnixSocketConnection> const& connection) {
+            // everything that was read in one go is handled in the same batch
+            std::vector<ipc::Frame> requests;
+            bool open = true;
+            auto status = UnixSocketConnection::ReceiveResult::Received;
+            while (
+                open && status == UnixSocketConnection::ReceiveResult::Received &&
+                connection->pendingRequests + requests.size() < ipc::MAX_PENDING_REQUESTS
+            ) {
+                status = connection->receive();
+                open = status != UnixSocketConnection::ReceiveResult::Closed;
+                // frames are taken out after every read, so a large frame
+                // that has been read in full is alone in its buffer
+                while (true) {
+                    auto frame = connection->reader.next();
+                    if (!frame) {
+                        log::warn("Closing IPC connection: {}", frame.unwrapErr());
+                        open = false;
+                        break;
+                    }
+                    if (!frame.unwrap()) {
+                        break;
+                    }
+                    requests.push_back(std::move(*frame.unwrap()));
+                }
+            }
+            ipc::queueRequests(connection, std::move(requests));
+            return open;
+        }
+
+    public:
+        ~UnixSocketServer() {
+            for (auto fd : { m_listener, m_wakeupRead, m_wakeupWrite }) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        }
+
+        Result<> listen() {
+            m_listener = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (m_listener < 0 || !setNonBlocking(m_listener)) {
+                return Err("Unable to create socket: {}", std::strerror(errno));
+            }
+
+            sockaddr_un address {};
+            address.sun_family = AF_UNIX;
+        #ifdef GEODE_IS_ANDROID
+            // the abstract namespace doesn't need a path other apps (and adb)
+            // are allowed to access
+            std::strncpy(address.sun_path + 1, ipc::IPC_SOCKET_NAME, sizeof(address.sun_path) - 2);
+            auto addressSize = static_cast<socklen_t>(
+                offsetof(sockaddr_un, sun_path) + 1 + std::strlen(ipc::IPC_SOCKET_NAME)
+            );
+        #else
+            std::strncpy(address.sun_path, ipc::IPC_SOCKET_PATH, sizeof(address.sun_path) - 1);
+            auto addressSize = static_cast<socklen_t>(sizeof(address));
+        #endif
+
+            auto const bindSocket = [&] {
+                return bind(m_listener, reinterpret_cast<sockaddr*>(&address), addressSize) == 0;
+            };
+            if (!bindSocket()) {
+            #ifdef GEODE_IS_ANDROID
+                return Err("Unable to bind socket: {}", std::strerror(errno));
+            #else
+                // the socket file is left behind if the game didn't exit
+                // cleanly, but shouldn't be taken from another running game
+                auto probe = socket(AF_UNIX, SOCK_STREAM, 0);
+                bool const inUse = probe >= 0 &&
+                    connect(probe, reinterpret_cast<sockaddr*>(&address), addressSize) == 0;
+                if (probe >= 0) {
+                    ::close(probe);
+                }
+                if (inUse) {
+                    return Err("Another instance of the game is already using {}", ipc::IPC_SOCKET_PATH);
+                }
+                unlink(ipc::IPC_SOCKET_PATH);
+                if (!bindSocket()) {
+                    return Err("Unable to bind socket: {}", std::strerror(errno));
+                }
+            #endif
+            }
+            if (::listen(m_listener, SOMAXCONN) != 0) {
+                return Err("Unable to listen on socket: {}", std::strerror(errno));
+            }
+
+            int fds[2];
+            if (pipe(fds) != 0 || !setNonBlocking(fds[0]) || !setNonBlocking(fds[1])) {
+                return Err("Unable to create wakeup pipe: {}", std::strerror(errno));
+            }
+            m_wakeupRead = fds[0];
+            m_wakeupWrite = fds[1];
+            return Ok();
+        }
+
+        void run() {
+            thread::setName("Geode Main IPC");
+
+            std::vector<pollfd> fds;
+            while (true) {
+                fds.clear();
+                fds.push_back({ m_wakeupRead, POLLIN, 0 });
+                fds.push_back({ m_listener, POLLIN, 0 });
+                for (auto const& connection : m_connections) {
+                    auto pending = connection->pendingSize();
+                    short events = 0;
+                    // requests that are still waiting for the main thread
+                    // count too, as their replies haven't been queued yet
+                    if (
+                        pending < MAX_BUFFERED_REPLIES &&
+                        connection->pendingRequests < ipc::MAX_PENDING_REQUESTS
+                    ) {
+                        events |= POLLIN;
+                    }
+                    if (pending > 0) {
+                        events |= POLLOUT;
+                    }
+                    fds.push_back({ connection->fd, events, 0 });
+                }
+
+                if (poll(fds.data(), fds.size(), -1) < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    log::warn("Unable to poll IPC sockets, quitting IPC: {}", std::strerror(errno));
+                    return;
+                }
+
+                if (fds[0].revents & POLLIN) {
+                    char buffer[256];
+                    while (::read(m_wakeupRead, buffer, sizeof(buffer)) > 0) {}
+                }
+                if (fds[1].revents & POLLIN) {
+                    this->accept();
+                }
+
+                // connections accepted just now weren't polled yet
+                std::vector<std::shared_ptr<UnixSocketConnection>> open;
+                for (size_t i = 0; i < m_connections.size(); i++) {
+                    auto& connection = m_connections[i];
+                    bool keep = true;
+                    if (i + 2 < fds.size()) {
+                        auto revents = fds[i + 2].revents;
+                        if (revents & (POLLIN | POLLHUP)) {
+                            keep = this->read(connection);
+                        }
+                        if (keep && (revents & POLLERR)) {
+                            keep = false;
+                        }
+                    }
+                    // replies may have been queued since polling
+                    if (keep) {
+                        keep = connection->flush();
+                    }
+                    if (keep) {
+                        open.push_back(std::move(connection));
+                    }
+                    else {
+                        connection->close();
+                    }
+                }
+                m_connections = std::move(open);
+            }
+        }
+    };
+}
+
+void ipc::setup() {
+    auto server = std::make_unique<UnixSocketServer>();
+    if (auto res = server->listen(); !res) {
+        log::warn("{}, quitting IPC", res.unwrapErr());
+        return;
+    }
+    std::thread([server = std::move(server)]() {
+        server->run();
+    }).detach();
+
+    log::debug("IPC set up");
+}
+
+#endif
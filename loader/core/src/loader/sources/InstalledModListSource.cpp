@@ -20,13 +20,13 @@ bool InstalledModsQuery::preCheck(ModSource const& src) const {
     }
     return true;
 }
-bool InstalledModsQuery::queryCheck(ModSource const& src, double& weighted) const {
+bool InstalledModsQuery::queryCheck(ModSource const& src, ModSearchIndex::Entry const& entry, double& weighted) const {
     bool addToList = true;
     if (enabledOnly) {
         addToList = src.asMod()->isEnabled() == *enabledOnly;
     }
     if (query) {
-        addToList = modFuzzyMatch(src.asMod()->getMetadata(), *query, weighted);
+        addToList = entry.fuzzyMatch(*query, ModSearchIndex::charMask(*query), weighted);
     }
     // Loader gets boost to ensure it's normally always top of the list
     if (addToList && src.asMod()->isInternal()) {
@@ -87,9 +87,11 @@ InstalledModListSource::ProviderTask InstalledModListSource::fetchPage(size_t pa
     }
 
     auto content = ModListSource::ProvidedMods();
-    for (auto& mod : Loader::get()->getAllMods()) {
+    auto allMods = Loader::get()->getAllMods();
+    for (auto& mod : allMods) {
         content.mods.push_back(ModSource(mod));
     }
+    m_searchIndex.update(allMods);
     // If we're only checking mods that have updates, we first have to run 
     // update checks every mod...
     if (m_query.type == InstalledModListType::OnlyUpdates && content.mods.size()) {
@@ -99,10 +101,10 @@ InstalledModListSource::ProviderTask InstalledModListSource::fetchPage(size_t pa
             tasks.push_back(src.checkUpdates());
         }
         return UpdateTask::all(std::move(tasks)).map(
-            [content = std::move(content), query = m_query](auto*) mutable -> ProviderTask::Value {
+            [this, content = std::move(content), query = m_query](auto*) mutable -> ProviderTask::Value {
                 // Filter the results based on the current search 
                 // query and return them
-                filterModsWithLocalQuery(content, query);
+                filterModsWithLocalQuery(content, query, m_searchIndex);
                 return Ok(content);
             },
             [](auto*) -> ProviderTask::Progress { return std::nullopt; }
@@ -110,7 +112,7 @@ InstalledModListSource::ProviderTask InstalledModListSource::fetchPage(size_t pa
     }
     // Otherwise simply construct the result right away
     else {
-        filterModsWithLocalQuery(content, m_query);
+        filterModsWithLocalQuery(content, m_query, m_searchIndex);
         return ProviderTask::immediate(Ok(content));
     }
 }
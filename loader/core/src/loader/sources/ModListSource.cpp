@@ -29,12 +29,39 @@ bool LocalModsQueryBase::isDefault() const {
 }
 
 typename ModListSource::PageLoadTask ModListSource::loadPage(size_t page, PageCreator&& pageCreator, bool forceUpdate) {
-    if (!forceUpdate && m_cachedPages.contains(page)) {
-        return PageLoadTask::immediate(Ok(m_cachedPages.at(page)));
+    m_pageCreator = std::move(pageCreator);
+
+    // Finished loads have already been cached (or failed), so forget them
+    std::erase_if(m_pendingPages, [](auto const& pair) {
+        return !pair.second.task.isPending();
+    });
+
+    if (!forceUpdate) {
+        if (m_cachedPages.contains(page)) {
+            this->prefetchPagesAround(page);
+            return PageLoadTask::immediate(Ok(m_cachedPages.at(page)));
+        }
+        // If this page is already being loaded, wait for that instead
+        if (auto pending = m_pendingPages.find(page); pending != m_pendingPages.end()) {
+            pending->second.prefetch = false;
+            return pending->second.task;
+        }
+    }
+    else if (auto pending = m_pendingPages.find(page); pending != m_pendingPages.end() && pending->second.prefetch) {
+        pending->second.task.shallowCancel();
     }
+
     m_cachedPages.erase(page);
+    auto task = this->fetchAndCachePage(page, forceUpdate, false);
+    m_pendingPages.insert_or_assign(page, PendingPage { task, false });
+    return task;
+}
+
+typename ModListSource::PageLoadTask ModListSource::fetchAndCachePage(size_t page, bool forceUpdate, bool prefetch) {
     return this->fetchPage(page, forceUpdate).map(
-        [this, pageCreator, page](Result<ProvidedMods, LoadPageError>* result) -> Result<std::shared_ptr<ModListPage>, LoadPageError> {
+        [this, pageCreator = m_pageCreator, page, prefetch, generation = m_cacheGeneration](
+            Result<ProvidedMods, LoadPageError>* result
+        ) -> Result<std::shared_ptr<ModListPage>, LoadPageError> {
             if (result->isOk()) {
                 auto data = result->unwrap();
                 if (data.totalModCount == 0 || data.mods.empty()) {
@@ -47,8 +74,16 @@ typename ModListSource::PageLoadTask ModListSource::loadPage(size_t page, PageCr
                 for (auto& src : data.mods) {
                     pageData->addModSource(std::move(src));
                 }
-                m_cachedItemCount = data.totalModCount;
-                m_cachedPages.insert({ page, pageData });
+                // Don't cache pages of a query that has changed since
+                if (generation == m_cacheGeneration) {
+                    m_cachedItemCount = data.totalModCount;
+                    m_cachedPages.insert({ page, pageData });
+                    // Prefetched pages don't prefetch further, as that would 
+                    // end up loading every page there is
+                    if (!prefetch) {
+                        this->prefetchPagesAround(page);
+                    }
+                }
                 return Ok(pageData);
             }
             else {
@@ -58,6 +93,29 @@ typename ModListSource::PageLoadTask ModListSource::loadPage(size_t page, PageCr
     );
 }
 
+void ModListSource::prefetchPagesAround(size_t page) {
+    // Local mods lists are built in a single frame anyway, so only server 
+    // lists benefit from prefetching
+    if (this->isLocalModsOnly() || !m_pageCreator) {
+        return;
+    }
+    auto pageCount = this->getPageCount();
+    if (!pageCount) {
+        return;
+    }
+    std::vector<size_t> neighbors { page + 1 };
+    if (page > 0) {
+        neighbors.push_back(page - 1);
+    }
+    for (auto neighbor : neighbors) {
+        if (neighbor >= *pageCount || m_cachedPages.contains(neighbor) || m_pendingPages.contains(neighbor)) {
+            continue;
+        }
+        auto task = this->fetchAndCachePage(neighbor, false, true);
+        m_pendingPages.insert({ neighbor, PendingPage { std::move(task), true } });
+    }
+}
+
 std::optional<size_t> ModListSource::getPageCount() const {
     return m_cachedItemCount ? std::optional(ceildiv(m_cachedItemCount.value(), m_pageSize)) : std::nullopt;
 }
@@ -76,6 +134,15 @@ void ModListSource::reset() {
     this->clearCache();
 }
 void ModListSource::clearCache() {
+    // Prefetches are for the old query, so stop waiting for them. Only cancel 
+    // our own task, as the server request itself may be cached and shared
+    for (auto& [_, pending] : m_pendingPages) {
+        if (pending.prefetch) {
+            pending.task.shallowCancel();
+        }
+    }
+    m_pendingPages.clear();
+    m_cacheGeneration += 1;
     m_cachedPages.clear();
     m_cachedItemCount = std::nullopt;
     InvalidateCacheEvent(this).post();
@@ -103,6 +170,80 @@ bool weightedFuzzyMatch(std::string const& str, std::string const& kw, double we
     }
     return false;
 }
+uint64_t ModSearchIndex::charMask(std::string_view str) {
+    // letters and digits get their own bit, everything else shares the rest
+    uint64_t mask = 0;
+    for (auto c : str) {
+        auto lower = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+        if (lower >= 'a' && lower <= 'z') {
+            mask |= uint64_t(1) << (lower - 'a');
+        }
+        else if (lower >= '0' && lower <= '9') {
+            mask |= uint64_t(1) << (26 + lower - '0');
+        }
+        else {
+            mask |= uint64_t(1) << (36 + lower % 28);
+        }
+    }
+    return mask;
+}
+
+bool ModSearchIndex::Entry::fuzzyMatch(std::string const& kw, uint64_t kwChars, double& weighted) const {
+    bool addToList = false;
+    for (auto& field : fields) {
+        if ((kwChars & field.chars) != kwChars) {
+            continue;
+        }
+        addToList |= weightedFuzzyMatch(field.text, kw, field.weight, weighted);
+    }
+    if (weighted < 2) {
+        addToList = false;
+    }
+    return addToList;
+}
+
+void ModSearchIndex::update(std::vector<Mod*> const& mods) {
+    std::unordered_set<Mod*> current(mods.begin(), mods.end());
+    std::erase_if(m_entries, [&](auto const& pair) {
+        return !current.contains(pair.first);
+    });
+    for (auto mod : mods) {
+        this->add(mod);
+    }
+}
+
+void ModSearchIndex::add(Mod* mod) {
+    if (m_entries.contains(mod)) {
+        return;
+    }
+    auto metadata = mod->getMetadata();
+    auto entry = Entry();
+    auto addField = [&](std::string const& text, double weight) {
+        entry.fields.push_back({ text, charMask(text), weight });
+    };
+    // same fields and weights as modFuzzyMatch
+    addField(metadata.getName(), 1);
+    addField(metadata.getID(), 0.5);
+    for (auto& dev : metadata.getDevelopers()) {
+        addField(dev, 0.25);
+    }
+    if (auto details = metadata.getDetails()) {
+        addField(*details, 0.005);
+    }
+    if (auto desc = metadata.getDescription()) {
+        addField(*desc, 0.02);
+    }
+    entry.tags = metadata.getTags();
+    entry.foldedName = utils::string::toLower(metadata.getName());
+    entry.outdated = metadata.checkTargetVersions().isErr();
+    m_entries.emplace(mod, std::move(entry));
+}
+
+ModSearchIndex::Entry const& ModSearchIndex::get(Mod* mod) {
+    this->add(mod);
+    return m_entries.at(mod);
+}
+
 bool modFuzzyMatch(ModMetadata const& metadata, std::string const& kw, double& weighted) {
     bool addToList = false;
     addToList |= weightedFuzzyMatch(metadata.getName(), kw, 1, weighted);
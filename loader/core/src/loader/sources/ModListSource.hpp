@@ -56,14 +56,30 @@ public:
     using ProviderTask = Task<Result<ProvidedMods, LoadPageError>, std::optional<uint8_t>>;
 
 protected:
+    struct PendingPage {
+        PageLoadTask task;
+        // Whether this is a speculative prefetch that nobody has asked for yet
+        bool prefetch;
+    };
+
     std::unordered_map<size_t, std::shared_ptr<ModListPage>> m_cachedPages;
+    // Pages that are currently being loaded, so that loading the same page 
+    // again shares the request instead of starting a new one
+    std::unordered_map<size_t, PendingPage> m_pendingPages;
     std::optional<size_t> m_cachedItemCount;
     size_t m_pageSize = 10;
+    // Bumped whenever the cache is cleared, so pages that finish loading for 
+    // an outdated query don't get cached
+    size_t m_cacheGeneration = 0;
+    PageCreator m_pageCreator;
 
     virtual void resetQuery() = 0;
     virtual ProviderTask fetchPage(size_t page, bool forceUpdate) = 0;
     virtual void setSearchQuery(std::string const& query) = 0;
 
+    PageLoadTask fetchAndCachePage(size_t page, bool forceUpdate, bool prefetch);
+    void prefetchPagesAround(size_t page);
+
     ModListSource();
 
 public:
@@ -106,6 +122,40 @@ public:
     }
 };
 
+// Search data for local mods that is computed once per mod instead of on every 
+// keystroke. Fuzzy matching only ever matches a field if every character of the 
+// query appears in it, so each field stores which characters it contains and 
+// fields that can't possibly match are skipped without running the matcher
+class ModSearchIndex final {
+public:
+    struct Field final {
+        std::string text;
+        uint64_t chars;
+        double weight;
+    };
+    struct Entry final {
+        std::vector<Field> fields;
+        std::unordered_set<std::string> tags;
+        // sort keys
+        std::string foldedName;
+        bool outdated;
+
+        bool fuzzyMatch(std::string const& kw, uint64_t kwChars, double& weighted) const;
+    };
+
+protected:
+    std::unordered_map<Mod*, Entry> m_entries;
+
+    void add(Mod* mod);
+
+public:
+    static uint64_t charMask(std::string_view str);
+
+    // Add entries for new mods and drop ones that are no longer in the list
+    void update(std::vector<Mod*> const& mods);
+    Entry const& get(Mod* mod);
+};
+
 struct LocalModsQueryBase {
     std::optional<std::string> query;
     std::unordered_set<std::string> tags = {};
@@ -124,7 +174,7 @@ struct InstalledModsQuery final : public LocalModsQueryBase {
     InstalledModListType type = InstalledModListType::All;
     std::optional<bool> enabledOnly;
     bool preCheck(ModSource const& src) const;
-    bool queryCheck(ModSource const& src, double& weighted) const;
+    bool queryCheck(ModSource const& src, ModSearchIndex::Entry const& entry, double& weighted) const;
     bool isDefault() const;
 };
 
@@ -132,6 +182,7 @@ class InstalledModListSource : public ModListSource {
 protected:
     InstalledModListType m_type;
     InstalledModsQuery m_query;
+    ModSearchIndex m_searchIndex;
 
     void resetQuery() override;
     ProviderTask fetchPage(size_t page, bool forceUpdate) override;
@@ -208,64 +259,60 @@ bool weightedFuzzyMatch(std::string const& str, std::string const& kw, double we
 bool modFuzzyMatch(ModMetadata const& metadata, std::string const& kw, double& out);
 
 template <std::derived_from<LocalModsQueryBase> Query>
-void filterModsWithLocalQuery(ModListSource::ProvidedMods& mods, Query const& query) {
-    std::vector<std::pair<ModSource, double>> filtered;
+void filterModsWithLocalQuery(ModListSource::ProvidedMods& mods, Query const& query, ModSearchIndex& index) {
+    struct Filtered {
+        ModSource* src;
+        ModSearchIndex::Entry const* entry;
+        double weighted;
+    };
+    std::vector<Filtered> filtered;
+    filtered.reserve(mods.mods.size());
 
     // Filter installed mods based on query
     // TODO: maybe skip fuzzy matching altogether if query is empty?
     for (auto& src : mods.mods) {
         double weighted = 0;
-        bool addToList = true;
         // Do any checks additional this query has to start off with
         if (!query.preCheck(src)) {
-            addToList = false;
+            continue;
         }
+        auto& entry = index.get(src.asMod());
         // If some tags are provided, only return mods that match
-        if (addToList && query.tags.size()) {
-            auto compare = src.getMetadata().getTags();
-            for (auto& tag : query.tags) {
-                if (!compare.contains(tag)) {
-                    addToList = false;
-                }
-            }
+        if (!std::all_of(query.tags.begin(), query.tags.end(), [&](auto const& tag) {
+            return entry.tags.contains(tag);
+        })) {
+            continue;
         }
         // Don't bother with unnecessary fuzzy match calculations if this mod isn't going to be added anyway
-        if (addToList) {
-            addToList = query.queryCheck(src, weighted);
-        }
-        if (addToList) {
-            filtered.push_back({ src, weighted });
+        if (query.queryCheck(src, entry, weighted)) {
+            filtered.push_back({ &src, &entry, weighted });
         }
     }
 
     // Sort list based on score
-    std::sort(filtered.begin(), filtered.end(), [](auto a, auto b) {
+    std::sort(filtered.begin(), filtered.end(), [](Filtered const& a, Filtered const& b) {
         // Sort primarily by score
-        if (a.second != b.second) {
-            return a.second > b.second;
+        if (a.weighted != b.weighted) {
+            return a.weighted > b.weighted;
         }
         // Make sure outdated mods are always last by default
-        auto aIsOutdated = a.first.getMetadata().checkTargetVersions().isErr();
-        auto bIsOutdated = b.first.getMetadata().checkTargetVersions().isErr();
-        if (aIsOutdated != bIsOutdated) {
-            return !aIsOutdated;
+        if (a.entry->outdated != b.entry->outdated) {
+            return !a.entry->outdated;
         }
         // Fallback sort alphabetically
-        return utils::string::caseInsensitiveCompare(
-            a.first.getMetadata().getName(),
-            b.first.getMetadata().getName()
-        ) == std::strong_ordering::less;
+        return a.entry->foldedName < b.entry->foldedName;
     });
 
-    mods.mods.clear();
+    std::vector<ModSource> page;
     // Pick out only the mods in the page and page size specified in the query
     for (
         size_t i = query.page * query.pageSize;
         i < filtered.size() && i < (query.page + 1) * query.pageSize;
         i += 1
     ) {
-        mods.mods.push_back(filtered.at(i).first);
+        page.push_back(std::move(*filtered.at(i).src));
     }
     
     mods.totalModCount = filtered.size();
+    mods.mods = std::move(page);
 }
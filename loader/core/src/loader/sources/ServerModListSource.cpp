@@ -5,9 +5,11 @@ void ServerModListSource::resetQuery() {
 }
 
 ServerModListSource::ProviderTask ServerModListSource::fetchPage(size_t page, bool forceUpdate) {
-    m_query.page = page;
-    m_query.pageSize = m_pageSize;
-    return server::getMods(m_query, !forceUpdate).map(
+    // Pages may be prefetched, so don't store the page in the shared query
+    auto query = m_query;
+    query.page = page;
+    query.pageSize = m_pageSize;
+    return server::getMods(query, !forceUpdate).map(
         [](Result<server::ServerModsList, server::ServerError>* result) -> ProviderTask::Value {
             if (result->isOk()) {
                 auto list = result->unwrap();
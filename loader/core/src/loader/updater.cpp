@@ -1,16 +1,44 @@
 ﻿#include "updater.hpp"
 #include <Geode/utils/web.hpp>
 #include <internal/resources.hpp>
+#include <internal/tracing.hpp>
 #include <Geode/utils/hash.hpp>
 #include <utility>
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
 #include <Geode/utils/string.hpp>
+#include <Geode/utils/ranges.hpp>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
 
 using namespace geode::prelude;
 
 static std::unordered_map<std::string, web::WebTask> RUNNING_REQUESTS {};
 
+// Resources that failed verification, so only they get replaced once the
+// resources have been downloaded. Empty means everything gets replaced
+static std::unordered_set<std::string> s_resourcesToRepair;
+
+// Extract downloaded resources, only replacing the files that failed
+// verification if the download has all of them
+static Result<> extractLoaderResources(file::Unzip& unzip, std::filesystem::path const& dir) {
+    auto repair = std::exchange(s_resourcesToRepair, {});
+    for (auto& name : repair) {
+        if (!unzip.hasEntry(name)) {
+            repair.clear();
+            break;
+        }
+    }
+    if (repair.empty()) {
+        return unzip.extractAllTo(dir);
+    }
+    for (auto& name : repair) {
+        GEODE_UNWRAP(unzip.extractTo(name, dir / name));
+    }
+    return Ok();
+}
+
 updater::ResourceDownloadEvent::ResourceDownloadEvent(
     UpdateStatus status
 ) : status(std::move(status)) {}
@@ -146,7 +174,7 @@ void updater::tryDownloadLoaderResources(std::string const& url, bool tryLatestO
                 // unzip resources zip
                 auto unzip = file::Unzip::create(response->data());
                 if (unzip) {
-                    auto ok = unzip.unwrap().extractAllTo(resourcesDir);
+                    auto ok = extractLoaderResources(unzip.unwrap(), resourcesDir);
                     if (ok) {
                         updater::updateSpecialFiles();
                         ResourceDownloadEvent(UpdateFinished()).post();
@@ -238,11 +266,59 @@ void updater::downloadLoaderResources(bool useLatestRelease) {
     ));
 }
 
+namespace {
+    struct ResourceFile {
+        std::string name;
+        std::filesystem::path path;
+        uintmax_t size = 0;
+        int64_t modified = 0;
+        std::string hash;
+    };
+}
+
+// Saved value holding the hash of every resource file along with the size
+// and modification time it had when it was hashed
+static constexpr auto RESOURCE_HASH_CACHE_KEY = "resource-hash-cache";
+
+static Result<std::string> getCachedResourceHash(matjson::Value const& cache, ResourceFile const& file) {
+    auto entry = GEODE_UNWRAP(cache.get(file.name));
+    auto size = GEODE_UNWRAP(GEODE_UNWRAP(entry.get("size")).as<uint64_t>());
+    auto modified = GEODE_UNWRAP(GEODE_UNWRAP(entry.get("modified")).as<int64_t>());
+    if (size != file.size || modified != file.modified) {
+        return Err("File has changed");
+    }
+    return GEODE_UNWRAP(entry.get("hash")).asString();
+}
+
+// Hash files over a few worker threads, as this runs during the loading screen
+static void hashResourceFiles(std::vector<ResourceFile*> const& files) {
+    std::atomic_size_t next = 0;
+    auto work = [&] {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            // if we hash anything other than text, change this
+            files[i]->hash = calculateSHA256Text(files[i]->path);
+        }
+    };
+    auto threadCount = std::min<size_t>(files.size(), std::max(std::thread::hardware_concurrency(), 1u));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back([&] {
+            thread::setName("Resource Verifier");
+            work();
+        });
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 bool updater::verifyLoaderResources() {
     static std::optional<bool> CACHED = std::nullopt;
     if (CACHED.has_value()) {
         return CACHED.value();
     }
+    tracing::Span span("Verify loader resources", "loader");
 
     // geode/resources/geode.loader
     auto resourcesDir = dirs::getGeodeResourcesDir() / Mod::get()->getID();
@@ -266,31 +342,68 @@ bool updater::verifyLoaderResources() {
         return true;
     }
 
-    // make sure every file was covered
-    size_t coverage = 0;
-
-    // verify hashes
-    for (auto& file : std::filesystem::directory_iterator(resourcesDir)) {
-        auto name = file.path().filename().string();
+    std::vector<ResourceFile> files;
+    for (auto& entry : std::filesystem::directory_iterator(resourcesDir)) {
+        auto name = entry.path().filename().string();
         // skip unknown files
         if (!LOADER_RESOURCE_HASHES.count(name)) {
             continue;
         }
-        // verify hash
-        // if we hash anything other than text, change this
-        auto hash = calculateSHA256Text(file.path());
-        const auto& expected = LOADER_RESOURCE_HASHES.at(name);
-        if (hash != expected) {
-            log::debug("Resource hash mismatch: {} ({}, {})", name, hash.substr(0, 7), expected.substr(0, 7));
-            updater::downloadLoaderResources();
-            return false;
+        std::error_code ec;
+        auto size = entry.file_size(ec);
+        auto modified = entry.last_write_time(ec);
+        files.push_back(ResourceFile {
+            .name = name,
+            .path = entry.path(),
+            .size = size,
+            .modified = static_cast<int64_t>(modified.time_since_epoch().count()),
+        });
+    }
+
+    // only hash files that have changed since they were last hashed
+    auto cache = Mod::get()->getSavedValue<matjson::Value>(RESOURCE_HASH_CACHE_KEY);
+    std::vector<ResourceFile*> toHash;
+    for (auto& file : files) {
+        if (auto hash = getCachedResourceHash(cache, file)) {
+            file.hash = hash.unwrap();
+        }
+        else {
+            toHash.push_back(&file);
+        }
+    }
+    if (!toHash.empty()) {
+        hashResourceFiles(toHash);
+
+        auto newCache = matjson::makeObject({});
+        for (auto& file : files) {
+            newCache[file.name] = matjson::makeObject({
+                { "size", static_cast<uint64_t>(file.size) },
+                { "modified", file.modified },
+                { "hash", file.hash },
+            });
+        }
+        Mod::get()->setSavedValue(RESOURCE_HASH_CACHE_KEY, newCache);
+    }
+
+    // collect every file that's wrong instead of stopping at the first one
+    std::vector<std::string> mismatched;
+    for (auto& file : files) {
+        auto const& expected = LOADER_RESOURCE_HASHES.at(file.name);
+        if (file.hash != expected) {
+            log::debug("Resource hash mismatch: {} ({}, {})", file.name, file.hash.substr(0, 7), expected.substr(0, 7));
+            mismatched.push_back(file.name);
+        }
+    }
+    for (auto& [name, _] : LOADER_RESOURCE_HASHES) {
+        if (!ranges::contains(files, [&](ResourceFile const& file) { return file.name == name; })) {
+            log::debug("Resource missing: {}", name);
+            mismatched.push_back(name);
         }
-        coverage += 1;
     }
 
-    // make sure every file was found
-    if (coverage != LOADER_RESOURCE_HASHES.size()) {
-        log::debug("Resource coverage mismatch");
+    if (!mismatched.empty()) {
+        log::info("Resources need to be repaired: {}", ranges::join(mismatched, ", "));
+        s_resourcesToRepair = std::unordered_set<std::string>(mismatched.begin(), mismatched.end());
         updater::downloadLoaderResources();
         return false;
     }
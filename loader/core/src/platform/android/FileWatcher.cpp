@@ -1,4 +1,5 @@
 #include <FileWatcher.hpp>
+#include "InotifyWatcher.hpp"
 
 FileWatcher::FileWatcher(
     std::filesystem::path const& file, FileWatchCallback callback, ErrorCallback error
@@ -9,15 +10,30 @@ FileWatcher::FileWatcher(
     m_file = file;
     m_callback = callback;
     m_error = error;
+    this->watch();
 }
 
 FileWatcher::~FileWatcher() {
+    if (m_platformHandle) {
+        InotifyWatcher::get().remove(reinterpret_cast<uintptr_t>(m_platformHandle));
+    }
 }
 
 void FileWatcher::watch() {
-	// TODO: setup inotify or something
+    // Capture the callback instead of this, since watchers can be moved
+    std::string error;
+    auto id = InotifyWatcher::get().add(m_file, [callback = m_callback](auto const& path) {
+        if (callback) {
+            callback(path);
+        }
+    }, error);
+    if (!id) {
+        if (m_error) m_error(error);
+        return;
+    }
+    m_platformHandle = reinterpret_cast<void*>(static_cast<uintptr_t>(id));
 }
 
 bool FileWatcher::watching() const {
-    return false;
+    return m_platformHandle && InotifyWatcher::get().isWatching(reinterpret_cast<uintptr_t>(m_platformHandle));
 }
@@ -1,9 +0,0 @@
-﻿#include <Geode/core/Prelude.hpp>
-#include <loader/IPC.hpp>
-#include <Geode/loader/Log.hpp>
-
-using namespace geode::prelude;
-
-void ipc::setup() {
-    log::debug("IPC is not supported on this platform!");
-}
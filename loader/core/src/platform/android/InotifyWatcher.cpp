@@ -0,0 +1,246 @@
+#include "InotifyWatcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Directories are watched for everything that can mean one of their children
+// changed, including files being replaced through a rename
+static constexpr uint32_t WATCH_MASK =
+    IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM;
+// Events that count as a change for a watched file; unlike directories,
+// files being removed isn't reported
+static constexpr uint32_t FILE_CHANGE_MASK =
+    IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_MOVED_TO;
+
+InotifyWatcher& InotifyWatcher::get() {
+    // Leaked on purpose: file watchers live in statics that may be destroyed
+    // after this one would be, and still remove their watches then
+    static auto instance = new InotifyWatcher();
+    return *instance;
+}
+
+InotifyWatcher::InotifyWatcher() {
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_inotify < 0 || m_epoll < 0 || m_wakeup < 0) {
+        return;
+    }
+
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = m_inotify;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_inotify, &event);
+    event.data.fd = m_wakeup;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event);
+}
+
+InotifyWatcher::~InotifyWatcher() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_exiting = true;
+    }
+    if (m_thread.joinable()) {
+        uint64_t one = 1;
+        (void)write(m_wakeup, &one, sizeof(one));
+        m_thread.join();
+    }
+    for (auto fd : { m_inotify, m_epoll, m_wakeup }) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+InotifyWatcher::WatchID InotifyWatcher::add(
+    std::filesystem::path const& path, Callback callback, std::string& error
+) {
+    if (m_inotify < 0 || m_epoll < 0 || m_wakeup < 0) {
+        error = "Unable to initialize inotify";
+        return 0;
+    }
+
+    std::error_code ec;
+    bool const isFile = !std::filesystem::is_directory(path, ec);
+    auto const directory = isFile ? path.parent_path() : path;
+
+    std::lock_guard lock(m_mutex);
+
+    // inotify returns the same descriptor when a directory is watched again,
+    // so all watches in a directory share it
+    auto descriptor = inotify_add_watch(m_inotify, directory.c_str(), WATCH_MASK);
+    if (descriptor < 0) {
+        error = std::string("Unable to watch directory: ") + std::strerror(errno);
+        return 0;
+    }
+
+    auto id = m_nextID++;
+    m_watches.emplace(id, Watch {
+        .path = path,
+        .name = isFile ? path.filename().string() : std::string(),
+        .descriptor = descriptor,
+        .callback = std::move(callback),
+        .firstChange = std::nullopt,
+        .lastChange = Clock::time_point(),
+    });
+    m_descriptors[descriptor].push_back(id);
+
+    if (!m_thread.joinable()) {
+        m_thread = std::thread(&InotifyWatcher::run, this);
+    }
+    return id;
+}
+
+void InotifyWatcher::remove(WatchID id) {
+    // Callbacks run with the mutex held, so once this has the lock the
+    // watch's callback can't be running anymore
+    std::lock_guard lock(m_mutex);
+    auto it = m_watches.find(id);
+    if (it == m_watches.end()) {
+        return;
+    }
+    auto descriptor = it->second.descriptor;
+    m_watches.erase(it);
+
+    auto ids = m_descriptors.find(descriptor);
+    if (ids == m_descriptors.end()) {
+        return;
+    }
+    std::erase(ids->second, id);
+    if (ids->second.empty()) {
+        m_descriptors.erase(ids);
+        inotify_rm_watch(m_inotify, descriptor);
+    }
+}
+
+bool InotifyWatcher::isWatching(WatchID id) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_watches.find(id);
+    return it != m_watches.end() && it->second.descriptor >= 0;
+}
+
+void InotifyWatcher::run() {
+    pthread_setname_np(pthread_self(), "File Watcher");
+
+    epoll_event events[2];
+    std::optional<Clock::time_point> deadline;
+    while (true) {
+        int timeout = -1;
+        if (deadline) {
+            auto wait = std::chrono::ceil<std::chrono::milliseconds>(*deadline - Clock::now());
+            timeout = static_cast<int>(std::max<int64_t>(wait.count(), 0));
+        }
+
+        auto count = epoll_wait(m_epoll, events, 2, timeout);
+        if (count < 0 && errno != EINTR) {
+            return;
+        }
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.fd == m_wakeup) {
+                uint64_t value;
+                (void)read(m_wakeup, &value, sizeof(value));
+            }
+            else if (events[i].data.fd == m_inotify) {
+                this->readEvents();
+            }
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_exiting) {
+                return;
+            }
+        }
+        deadline = this->dispatchDue();
+    }
+}
+
+void InotifyWatcher::readEvents() {
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        auto length = read(m_inotify, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN, all queued events have been read
+            return;
+        }
+
+        auto const now = Clock::now();
+        auto const markChanged = [now](Watch& watch) {
+            if (!watch.firstChange) {
+                watch.firstChange = now;
+            }
+            watch.lastChange = now;
+        };
+
+        std::lock_guard lock(m_mutex);
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            auto event = reinterpret_cast<inotify_event*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            // The kernel's queue filled up and events were dropped, so any
+            // watch may have missed a change
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (auto& [_, watch] : m_watches) {
+                    if (watch.descriptor >= 0) {
+                        markChanged(watch);
+                    }
+                }
+                continue;
+            }
+
+            auto ids = m_descriptors.find(event->wd);
+            if (ids == m_descriptors.end()) {
+                continue;
+            }
+
+            // The directory was deleted or unmounted
+            if (event->mask & IN_IGNORED) {
+                for (auto id : ids->second) {
+                    m_watches.at(id).descriptor = -1;
+                }
+                m_descriptors.erase(ids);
+                continue;
+            }
+
+            for (auto id : ids->second) {
+                auto& watch = m_watches.at(id);
+                if (!watch.name.empty()) {
+                    if (!(event->mask & FILE_CHANGE_MASK) || !event->len || watch.name != event->name) {
+                        continue;
+                    }
+                }
+                markChanged(watch);
+            }
+        }
+    }
+}
+
+std::optional<InotifyWatcher::Clock::time_point> InotifyWatcher::dispatchDue() {
+    auto const now = Clock::now();
+    std::optional<Clock::time_point> next;
+
+    std::lock_guard lock(m_mutex);
+    for (auto& [_, watch] : m_watches) {
+        if (!watch.firstChange) {
+            continue;
+        }
+        auto due = std::min(watch.lastChange + COALESCE_DELAY, *watch.firstChange + MAX_COALESCE_DELAY);
+        if (due > now) {
+            if (!next || due < *next) {
+                next = due;
+            }
+            continue;
+        }
+        watch.firstChange = std::nullopt;
+        if (watch.callback) {
+            watch.callback(watch.path);
+        }
+    }
+    return next;
+}
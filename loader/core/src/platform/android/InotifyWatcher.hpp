@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Watches any number of files and directories using a single inotify
+ * instance, served by one thread blocking on epoll. Rapid bursts of changes
+ * to the same path are coalesced into a single callback.
+ *
+ * This only depends on the standard library and Linux APIs, so it can be
+ * built and tested on a regular Linux machine
+ */
+class InotifyWatcher final {
+public:
+    using Callback = std::function<void(std::filesystem::path const&)>;
+    using WatchID = uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    // How long a path has to stay quiet before its change is reported, so
+    // that saving a file in several writes only reports it once
+    static constexpr auto COALESCE_DELAY = std::chrono::milliseconds(50);
+    // A path that keeps changing is still reported at least this often
+    static constexpr auto MAX_COALESCE_DELAY = std::chrono::milliseconds(500);
+
+    static InotifyWatcher& get();
+
+    InotifyWatcher();
+    ~InotifyWatcher();
+
+    InotifyWatcher(InotifyWatcher const&) = delete;
+    InotifyWatcher& operator=(InotifyWatcher const&) = delete;
+
+    /**
+     * Start watching a path. Files are watched through their parent
+     * directory, so they keep being watched when an editor saves them by
+     * replacing the file. Directories report changes to any of their
+     * direct children
+     * @param path The file or directory to watch
+     * @param callback Called on the watcher thread with the watched path
+     * whenever it has changed. All changes that are due at once are reported
+     * back-to-back. Must not call add or remove
+     * @param error Set to the reason if watching fails
+     * @returns The ID of the watch, or 0 on failure
+     */
+    WatchID add(std::filesystem::path const& path, Callback callback, std::string& error);
+    /**
+     * Stop watching. Once this returns, the watch's callback is not running
+     * and won't be called again
+     */
+    void remove(WatchID id);
+    /**
+     * Whether the watch exists and its directory still exists
+     */
+    bool isWatching(WatchID id);
+
+private:
+    struct Watch {
+        std::filesystem::path path;
+        // The file name within the watched directory, or empty if the
+        // directory itself is being watched
+        std::string name;
+        int descriptor;
+        Callback callback;
+        std::optional<Clock::time_point> firstChange;
+        Clock::time_point lastChange;
+    };
+
+    int m_inotify = -1;
+    int m_epoll = -1;
+    int m_wakeup = -1;
+    std::thread m_thread;
+    bool m_exiting = false;
+
+    std::mutex m_mutex;
+    std::unordered_map<WatchID, Watch> m_watches;
+    std::unordered_map<int, std::vector<WatchID>> m_descriptors;
+    WatchID m_nextID = 1;
+
+    void run();
+    void readEvents();
+    std::optional<Clock::time_point> dispatchDue();
+};
@@ -1,10 +1,8 @@
 #import <Foundation/Foundation.h>
-#include <Geode/loader/IPC.hpp>
 #include <Geode/loader/Log.hpp>
 #include <iostream>
 #include <loader/LoaderImpl.hpp>
 #include <loader/console.hpp>
-#include <loader/IPC.hpp>
 #include <loader/ModImpl.hpp>
 #include <sys/stat.h>
 #include <loader/LogImpl.hpp>
@@ -89,42 +87,6 @@ void console::openIfClosed() {
     s_isOpen = true;
 }
 
-CFDataRef msgPortCallback(CFMessagePortRef port, SInt32 messageID, CFDataRef data, void* info) {
-    if (!CFDataGetLength(data)) return NULL;
-
-    std::string cdata(reinterpret_cast<char const*>(CFDataGetBytePtr(data)), CFDataGetLength(data));
-
-    std::string reply = geode::ipc::processRaw(port, cdata).dump();
-
-    return CFDataCreate(NULL, (UInt8 const*)reply.data(), reply.size());
-}
-
-void geode::ipc::setup() {
-    std::thread([]() {
-        thread::setName("Geode Main IPC");
-
-        CFStringRef portName = CFStringCreateWithCString(NULL, IPC_PORT_NAME, kCFStringEncodingUTF8);
-
-        CFMessagePortRef localPort =
-            CFMessagePortCreateLocal(NULL, portName, msgPortCallback, NULL, NULL);
-        if (localPort == NULL) {
-            log::warn("Unable to create port, quitting IPC");
-            return;
-        }
-        CFRunLoopSourceRef runLoopSource = CFMessagePortCreateRunLoopSource(NULL, localPort, 0);
-
-        if (runLoopSource == NULL) {
-            log::warn("Unable to create loop source, quitting IPC");
-            return;
-        }
-
-        CFRunLoopAddSource(CFRunLoopGetCurrent(), runLoopSource, kCFRunLoopCommonModes);
-        CFRunLoopRun();
-        CFRelease(localPort);
-    }).detach();
-    log::debug("IPC set up");
-}
-
 bool Loader::Impl::userTriedToLoadDLLs() const {
     return false;
 }
@@ -123,34 +123,53 @@ public:
                         return;
                     }
 
+                    // Write the new package atomically, so the game crashing or 
+                    // a failed write never leaves a truncated .geode file or no 
+                    // package at all behind. This runs on the main thread, so 
+                    // it isn't synced to disk, which could stall a frame for a 
+                    // large mod
+                    auto packagePath = dirs::getModsDir() / (m_id + ".geode");
+                    auto ok = file::writeBinary(packagePath, value->data(), file::WriteMode::Atomic);
+                    if (!ok) {
+                        m_status = DownloadStatusError {
+                            .details = ok.unwrapErr(),
+                        };
+                        ModDownloadEvent(m_id).post();
+                        return;
+                    }
+
                     bool removingInstalledWasError = false;
                     std::string id = m_replacesMod.has_value() ? m_replacesMod.value() : m_id;
                     if (auto mod = Loader::get()->getInstalledMod(id)) {
+                        // If this was an update to a package with a different 
+                        // name, delete the old one; otherwise it has already 
+                        // been replaced
+                        auto oldPath = mod->getPackagePath();
                         std::error_code ec;
-                        std::filesystem::remove(mod->getPackagePath(), ec);
+                        if (!std::filesystem::equivalent(oldPath, packagePath, ec)) {
+                            ec.clear();
+                            std::filesystem::remove(oldPath, ec);
+                        }
                         if (ec) {
+                            // Don't leave two packages of the same mod in 
+                            // the mods folder; the old one stays installed
+                            std::error_code removeNewError;
+                            std::filesystem::remove(packagePath, removeNewError);
                             removingInstalledWasError = true;
                             m_status = DownloadStatusError {
                                 .details = fmt::format("Unable to delete existing .geode package (code {})", ec),
                             };
                         }
-                        // Mark mod as updated
-                        ModImpl::getImpl(mod)->m_requestedAction = ModRequestedAction::Update;
-                    }
-                    // If this was an update, delete the old file first
-                    if (!removingInstalledWasError) {
-                        auto ok = file::writeBinary(dirs::getModsDir() / (m_id + ".geode"), value->data());
-                        if (!ok) {
-                            m_status = DownloadStatusError {
-                                .details = ok.unwrapErr(),
-                            };
-                        }
                         else {
-                            m_status = DownloadStatusDone {
-                                .version = version
-                            };
+                            // Mark mod as updated
+                            ModImpl::getImpl(mod)->m_requestedAction = ModRequestedAction::Update;
                         }
                     }
+                    if (!removingInstalledWasError) {
+                        m_status = DownloadStatusDone {
+                            .version = version
+                        };
+                    }
                 }
                 else {
                     auto resp = event->getValue();
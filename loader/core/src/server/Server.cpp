@@ -214,6 +214,22 @@ static ServerProgress parseServerProgress(web::WebProgress const& prog, auto msg
     }
 }
 
+// Responses are parsed on a worker, but checking which of the mods they
+// mention are installed needs the loader, so it's done on the main thread.
+// The parsed task is only ever listened to by this mapping, so its value is
+// moved out instead of copying the whole list on the main thread
+template <class T>
+static ServerRequest<T> resolveInstalledMods(ServerRequest<T> const& request) {
+    return request.map([](Result<T, ServerError>* result) -> Result<T, ServerError> {
+        if (result->isErr()) {
+            return Err(result->unwrapErr());
+        }
+        auto value = std::move(*result).unwrap();
+        value.resolveInstalledMods();
+        return Ok(std::move(value));
+    });
+}
+
 const char* server::sortToString(ModsSort sorting) {
     switch (sorting) {
         default:
@@ -331,12 +347,6 @@ Result<ServerModVersion> ServerModVersion::parse(matjson::Value const& raw) {
         obj.needs("version").into(dependency.version);
         obj.hasNullable("importance").into(dependency.importance);
 
-        // Check if this dependency is installed, and if so assign the `mod` member to mark that
-        auto mod = Loader::get()->getInstalledMod(dependency.id);
-        if (mod && dependency.version.compare(mod->getVersion())) {
-            dependency.mod = mod;
-        }
-
         dependencies.push_back(dependency);
     }
     res.metadata.setDependencies(dependencies);
@@ -357,12 +367,6 @@ Result<ServerModVersion> ServerModVersion::parse(matjson::Value const& raw) {
 
         obj.needs("version").into(incompatibility.version);
 
-        // Check if this incompatability is installed, and if so assign the `mod` member to mark that
-        auto mod = Loader::get()->getInstalledMod(incompatibility.id);
-        if (mod && incompatibility.version.compare(mod->getVersion())) {
-            incompatibility.mod = mod;
-        }
-
         incompatibilities.push_back(incompatibility);
     }
     res.metadata.setIncompatibilities(incompatibilities);
@@ -370,6 +374,28 @@ Result<ServerModVersion> ServerModVersion::parse(matjson::Value const& raw) {
     return root.ok(res);
 }
 
+void ServerModVersion::resolveInstalledMods() {
+    // Check if each dependency is installed, and if so assign the `mod` member to mark that
+    auto dependencies = metadata.getDependencies();
+    for (auto& dependency : dependencies) {
+        auto mod = Loader::get()->getInstalledMod(dependency.id);
+        if (mod && dependency.version.compare(mod->getVersion())) {
+            dependency.mod = mod;
+        }
+    }
+    metadata.setDependencies(dependencies);
+
+    // Same for incompatibilities
+    auto incompatibilities = metadata.getIncompatibilities();
+    for (auto& incompatibility : incompatibilities) {
+        auto mod = Loader::get()->getInstalledMod(incompatibility.id);
+        if (mod && incompatibility.version.compare(mod->getVersion())) {
+            incompatibility.mod = mod;
+        }
+    }
+    metadata.setIncompatibilities(incompatibilities);
+}
+
 Result<ServerModReplacement> ServerModReplacement::parse(matjson::Value const& raw) {
     auto root = checkJson(raw, "ServerModReplacement");
     auto res = ServerModReplacement();
@@ -529,6 +555,18 @@ Result<ServerModsList> ServerModsList::parse(matjson::Value const& raw) {
     return payload.ok(list);
 }
 
+void ServerModMetadata::resolveInstalledMods() {
+    for (auto& version : versions) {
+        version.resolveInstalledMods();
+    }
+}
+
+void ServerModsList::resolveInstalledMods() {
+    for (auto& mod : mods) {
+        mod.resolveInstalledMods();
+    }
+}
+
 ModMetadata ServerModMetadata::latestVersion() const {
     return this->versions.front().metadata;
 }
@@ -604,7 +642,8 @@ ServerRequest<ServerModsList> server::getMods(ModsQuery const& query, bool useCa
     req.param("page", std::to_string(query.page + 1));
     req.param("per_page", std::to_string(query.pageSize));
 
-    return req.get(formatServerURL("/mods")).map(
+    return resolveInstalledMods(req.get(formatServerURL("/mods")).mapOn(
+        TaskExecutor::Worker,
         [](web::WebResponse* response) -> Result<ServerModsList, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -628,7 +667,7 @@ ServerRequest<ServerModsList> server::getMods(ModsQuery const& query, bool useCa
         [](web::WebProgress* progress) {
             return parseServerProgress(*progress, "Downloading mods");
         }
-    );
+    ));
 }
 
 ServerRequest<ServerModMetadata> server::getMod(std::string const& id, bool useCache) {
@@ -637,7 +676,8 @@ ServerRequest<ServerModMetadata> server::getMod(std::string const& id, bool useC
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
-    return req.get(formatServerURL("/mods/{}", id)).map(
+    return resolveInstalledMods(req.get(formatServerURL("/mods/{}", id)).mapOn(
+        TaskExecutor::Worker,
         [](web::WebResponse* response) -> Result<ServerModMetadata, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -657,7 +697,7 @@ ServerRequest<ServerModMetadata> server::getMod(std::string const& id, bool useC
         [id](web::WebProgress* progress) {
             return parseServerProgress(*progress, "Downloading metadata for " + id);
         }
-    );
+    ));
 }
 
 ServerRequest<ServerModVersion> server::getModVersion(std::string const& id, ModVersion const& version, bool useCache) {
@@ -692,7 +732,8 @@ ServerRequest<ServerModVersion> server::getModVersion(std::string const& id, Mod
         },
     }, version);
 
-    return req.get(formatServerURL("/mods/{}/versions/{}?gd={}&platforms={}", id, versionURL, Loader::get()->getGameVersion(), GEODE_PLATFORM_SHORT_IDENTIFIER)).map(
+    return resolveInstalledMods(req.get(formatServerURL("/mods/{}/versions/{}?gd={}&platforms={}", id, versionURL, Loader::get()->getGameVersion(), GEODE_PLATFORM_SHORT_IDENTIFIER)).mapOn(
+        TaskExecutor::Worker,
         [](web::WebResponse* response) -> Result<ServerModVersion, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -712,7 +753,7 @@ ServerRequest<ServerModVersion> server::getModVersion(std::string const& id, Mod
         [id](web::WebProgress* progress) {
             return parseServerProgress(*progress, "Downloading metadata for " + id);
         }
-    );
+    ));
 }
 
 ServerRequest<ByteVector> server::getModLogo(std::string const& id, bool useCache) {
@@ -740,7 +781,8 @@ ServerRequest<std::vector<ServerTag>> server::getTags(bool useCache) {
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
-    return req.get(formatServerURL("/detailed-tags")).map(
+    return req.get(formatServerURL("/detailed-tags")).mapOn(
+        TaskExecutor::Worker,
         [](web::WebResponse* response) -> Result<std::vector<ServerTag>, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -789,7 +831,8 @@ ServerRequest<std::vector<ServerModUpdate>> server::batchedCheckUpdates(std::vec
     req.param("geode", Loader::get()->getVersion().toNonVString());
 
     req.param("ids", ranges::join(batch, ";"));
-    return req.get(formatServerURL("/mods/updates")).map(
+    return req.get(formatServerURL("/mods/updates")).mapOn(
+        TaskExecutor::Worker,
         [](web::WebResponse* response) -> Result<std::vector<ServerModUpdate>, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -47,6 +47,9 @@ namespace server {
         bool operator==(ServerModVersion const&) const = default;
 
         static Result<ServerModVersion> parse(matjson::Value const& json);
+        // Marks which dependencies and incompatibilities are installed. Must 
+        // be called on the main thread
+        void resolveInstalledMods();
     };
     
     struct ServerModReplacement final {
@@ -90,6 +93,7 @@ namespace server {
         std::optional<ServerDateTime> updatedAt;
 
         static Result<ServerModMetadata> parse(matjson::Value const& json);
+        void resolveInstalledMods();
 
         ModMetadata latestVersion() const;
         std::string formatDevelopersToString() const;
@@ -101,6 +105,7 @@ namespace server {
         size_t totalModCount = 0;
 
         static Result<ServerModsList> parse(matjson::Value const& json);
+        void resolveInstalledMods();
     };
 
     enum class ModsSort {
@@ -0,0 +1,89 @@
+#include <Geode/utils/Task.hpp>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+using namespace geode::prelude;
+
+// Set while Task events are being delivered on the main thread
+static thread_local bool s_delivering = false;
+// Events scheduled during delivery that are delivered in the same pass
+static thread_local std::deque<ScheduledFunction> s_samePassEvents;
+
+void geode::geode_internal::scheduleTaskEvent(ScheduledFunction&& deliver, bool samePass) {
+    // s_delivering is thread-local, so this is only ever true on the main thread
+    if (samePass && s_delivering) {
+        s_samePassEvents.push_back(std::move(deliver));
+        return;
+    }
+    queueInMainThread([deliver = std::move(deliver)]() {
+        // Deliver this event and then everything scheduled by its listeners
+        // in FIFO order, so a whole chain of mapped Tasks finishes this frame
+        s_delivering = true;
+        deliver();
+        while (!s_samePassEvents.empty()) {
+            auto next = std::move(s_samePassEvents.front());
+            s_samePassEvents.pop_front();
+            next();
+        }
+        s_delivering = false;
+    });
+}
+
+namespace {
+    // A fixed number of threads that run the mappers of every
+    // `TaskExecutor::Worker` stage, started as they're first needed
+    class TaskWorkerPool final {
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<std::function<void()>> m_jobs;
+        size_t m_threads = 0;
+        size_t m_idle = 0;
+
+        // leave a core for the main thread
+        static size_t maxThreads() {
+            auto cores = std::thread::hardware_concurrency();
+            return cores > 1 ? cores - 1 : 1;
+        }
+
+        void work() {
+            thread::setName("Task Worker");
+            std::unique_lock lock(m_mutex);
+            while (true) {
+                m_idle += 1;
+                m_cv.wait(lock, [this] { return !m_jobs.empty(); });
+                m_idle -= 1;
+                auto job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+                lock.unlock();
+                job();
+                // destroy whatever the job captured before taking the lock
+                job = nullptr;
+                lock.lock();
+            }
+        }
+
+    public:
+        static TaskWorkerPool& get() {
+            // leaked so the workers never outlive it during static destruction
+            static auto pool = new TaskWorkerPool();
+            return *pool;
+        }
+
+        void run(std::function<void()>&& job) {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push_back(std::move(job));
+            if (m_idle >= m_jobs.size() || m_threads >= maxThreads()) {
+                m_cv.notify_one();
+                return;
+            }
+            m_threads += 1;
+            std::thread([this] { this->work(); }).detach();
+        }
+    };
+}
+
+void geode::geode_internal::runTaskWorker(std::function<void()>&& job) {
+    TaskWorkerPool::get().run(std::move(job));
+}
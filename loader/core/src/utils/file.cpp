@@ -13,9 +13,19 @@
 #include <mz_zip.h>
 #include <internal/FileWatcher.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <limits>
+#include <mutex>
 
 #ifdef GEODE_IS_WINDOWS
 #include <filesystem>
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #if defined(GEODE_IS_ANDROID) || defined(GEODE_IS_MACOS) || defined(GEODE_IS_IOS)
@@ -53,8 +63,11 @@ Result<std::string> utils::file::readString(std::filesystem::path const& path) {
 }
 
 Result<matjson::Value> utils::file::readJson(std::filesystem::path const& path) {
-    auto str = GEODE_UNWRAP(utils::file::readString(path));
-    return matjson::parse(str).mapErr([&](auto const& err) {
+    if (!std::filesystem::exists(path))
+        return Err("File does not exist");
+
+    auto file = GEODE_UNWRAP(MappedFile::open(path));
+    return matjson::parse(file.text()).mapErr([&](auto const& err) {
         return fmt::format("Unable to parse JSON: {}", err);
     });
 }
@@ -108,6 +121,320 @@ Result<> utils::file::writeBinary(std::filesystem::path const& path, ByteVector
     return Ok();
 }
 
+// Write data into a new file, flushing it to disk if requested
+static Result<> writeNewFile(std::filesystem::path const& path, const void* data, size_t size, bool sync) {
+    auto bytes = static_cast<const uint8_t*>(data);
+#ifdef GEODE_IS_WINDOWS
+    auto handle = CreateFileW(
+        path.wstring().c_str(), GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (handle == INVALID_HANDLE_VALUE) {
+        return Err("Unable to open file");
+    }
+    while (size > 0) {
+        DWORD written = 0;
+        auto chunk = static_cast<DWORD>(std::min<size_t>(size, 1 << 30));
+        if (!WriteFile(handle, bytes, chunk, &written, nullptr)) {
+            CloseHandle(handle);
+            return Err(fmt::format("Unable to write file (code {})", GetLastError()));
+        }
+        bytes += written;
+        size -= written;
+    }
+    if (sync && !FlushFileBuffers(handle)) {
+        CloseHandle(handle);
+        return Err(fmt::format("Unable to flush file (code {})", GetLastError()));
+    }
+    CloseHandle(handle);
+    return Ok();
+#else
+    auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return Err(fmt::format("Unable to open file: {}", std::strerror(errno)));
+    }
+    while (size > 0) {
+        auto written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            auto err = errno;
+            close(fd);
+            return Err(fmt::format("Unable to write file: {}", std::strerror(err)));
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    if (sync && fsync(fd) != 0) {
+        auto err = errno;
+        close(fd);
+        return Err(fmt::format("Unable to flush file: {}", std::strerror(err)));
+    }
+    if (close(fd) != 0) {
+        return Err(fmt::format("Unable to write file: {}", std::strerror(errno)));
+    }
+    return Ok();
+#endif
+}
+
+// Rename a file over another one, replacing it
+static Result<> replaceFile(std::filesystem::path const& from, std::filesystem::path const& to, bool sync) {
+#ifdef GEODE_IS_WINDOWS
+    DWORD flags = MOVEFILE_REPLACE_EXISTING;
+    if (sync) {
+        flags |= MOVEFILE_WRITE_THROUGH;
+    }
+    if (!MoveFileExW(from.wstring().c_str(), to.wstring().c_str(), flags)) {
+        return Err(fmt::format("Unable to replace file (code {})", GetLastError()));
+    }
+#else
+    if (::rename(from.c_str(), to.c_str()) != 0) {
+        return Err(fmt::format("Unable to replace file: {}", std::strerror(errno)));
+    }
+#endif
+    return Ok();
+}
+
+// Make sure renames in a directory have reached the disk
+static void syncDirectory(std::filesystem::path const& dir) {
+    // Windows can't flush directories; MOVEFILE_WRITE_THROUGH already waits 
+    // for the rename to be written
+#ifndef GEODE_IS_WINDOWS
+    auto fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#endif
+}
+
+static std::filesystem::path getTempWritePath(std::filesystem::path const& path) {
+    auto temp = path;
+    temp += ".tmp";
+    return temp;
+}
+
+static Result<> writeAtomically(std::filesystem::path const& path, const void* data, size_t size, bool sync) {
+    auto temp = getTempWritePath(path);
+    if (auto res = writeNewFile(temp, data, size, sync); !res) {
+        std::error_code ec;
+        std::filesystem::remove(temp, ec);
+        return res;
+    }
+    if (auto res = replaceFile(temp, path, sync); !res) {
+        std::error_code ec;
+        std::filesystem::remove(temp, ec);
+        return res;
+    }
+    if (sync) {
+        syncDirectory(path.parent_path());
+    }
+    return Ok();
+}
+
+Result<> utils::file::writeString(std::filesystem::path const& path, std::string const& data, WriteMode mode) {
+    if (mode == WriteMode::InPlace) {
+        return writeString(path, data);
+    }
+    return writeAtomically(path, data.data(), data.size(), mode == WriteMode::AtomicSynced);
+}
+
+Result<> utils::file::writeBinary(std::filesystem::path const& path, ByteVector const& data, WriteMode mode) {
+    if (mode == WriteMode::InPlace) {
+        return writeBinary(path, data);
+    }
+    return writeAtomically(path, data.data(), data.size(), mode == WriteMode::AtomicSynced);
+}
+
+Result<> utils::file::writeFiles(
+    std::vector<std::pair<std::filesystem::path, std::string>> const& files,
+    WriteMode mode
+) {
+    std::vector<std::string> errors;
+    if (mode == WriteMode::InPlace) {
+        for (auto& [path, data] : files) {
+            if (auto res = writeString(path, data); !res) {
+                errors.push_back(fmt::format("{} ({})", path.string(), res.unwrapErr()));
+            }
+        }
+    }
+    else {
+        bool sync = mode == WriteMode::AtomicSynced;
+
+        // Write everything first, so a failure can't leave only some of the 
+        // files replaced because of a problem with another file
+        std::vector<std::filesystem::path const*> written;
+        for (auto& [path, data] : files) {
+            auto temp = getTempWritePath(path);
+            if (auto res = writeNewFile(temp, data.data(), data.size(), sync); !res) {
+                errors.push_back(fmt::format("{} ({})", path.string(), res.unwrapErr()));
+                std::error_code ec;
+                std::filesystem::remove(temp, ec);
+                continue;
+            }
+            written.push_back(&path);
+        }
+
+        std::vector<std::filesystem::path> directories;
+        for (auto path : written) {
+            auto temp = getTempWritePath(*path);
+            if (auto res = replaceFile(temp, *path, sync); !res) {
+                errors.push_back(fmt::format("{} ({})", path->string(), res.unwrapErr()));
+                std::error_code ec;
+                std::filesystem::remove(temp, ec);
+                continue;
+            }
+            if (sync && !ranges::contains(directories, path->parent_path())) {
+                directories.push_back(path->parent_path());
+            }
+        }
+        for (auto& dir : directories) {
+            syncDirectory(dir);
+        }
+    }
+
+    if (!errors.empty()) {
+        return Err("Unable to write " + ranges::join(errors, ", "));
+    }
+    return Ok();
+}
+
+class MappedFile::Impl final {
+public:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    // Used when the file couldn't be mapped
+    ByteVector m_fallback;
+#ifdef GEODE_IS_WINDOWS
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+
+    bool isMapped() const {
+        return m_data && m_data != m_fallback.data();
+    }
+
+    Result<> map(std::filesystem::path const& path) {
+#ifdef GEODE_IS_WINDOWS
+        // Others may keep writing to the file, and replace or delete it, 
+        // while it's mapped; the atomic write modes rename over files that 
+        // may be open here (e.g. a .geode being updated while it's read)
+        m_file = CreateFileW(
+            path.wstring().c_str(), GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+        );
+        if (m_file == INVALID_HANDLE_VALUE) {
+            return Err("Unable to open file");
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size)) {
+            return Err("Unable to get file size");
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        // Empty files can't be mapped, but there's nothing to map anyway
+        if (m_size == 0) {
+            return Ok();
+        }
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping) {
+            return Err("Unable to map file");
+        }
+        auto view = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            return Err("Unable to map file");
+        }
+        m_data = static_cast<const uint8_t*>(view);
+        return Ok();
+#else
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return Err("Unable to open file");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            close(fd);
+            return Err("Unable to get file size");
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size == 0) {
+            close(fd);
+            return Ok();
+        }
+        auto view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps the file alive on its own
+        close(fd);
+        if (view == MAP_FAILED) {
+            return Err("Unable to map file");
+        }
+        m_data = static_cast<const uint8_t*>(view);
+        return Ok();
+#endif
+    }
+
+    void unmap() {
+#ifdef GEODE_IS_WINDOWS
+        if (this->isMapped()) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (this->isMapped()) {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    ~Impl() {
+        this->unmap();
+    }
+};
+
+MappedFile::MappedFile(std::unique_ptr<Impl>&& impl) : m_impl(std::move(impl)) {}
+MappedFile::MappedFile(MappedFile&& other) = default;
+MappedFile& MappedFile::operator=(MappedFile&& other) = default;
+MappedFile::~MappedFile() = default;
+
+Result<MappedFile> MappedFile::open(std::filesystem::path const& path) {
+    auto impl = std::make_unique<Impl>();
+    if (auto res = impl->map(path); !res) {
+        impl->unmap();
+        // Fall back to reading the whole file normally
+        GEODE_UNWRAP_INTO(impl->m_fallback, file::readBinary(path).mapErr([&](auto const& err) {
+            return fmt::format("{} ({})", err, res.unwrapErr());
+        }));
+        impl->m_data = impl->m_fallback.data();
+        impl->m_size = impl->m_fallback.size();
+    }
+    return Ok(MappedFile(std::move(impl)));
+}
+
+std::span<const uint8_t> MappedFile::data() const {
+    return std::span(m_impl->m_data, m_impl->m_size);
+}
+
+std::string_view MappedFile::text() const {
+    return std::string_view(reinterpret_cast<const char*>(m_impl->m_data), m_impl->m_size);
+}
+
+size_t MappedFile::size() const {
+    return m_impl->m_size;
+}
+
+bool MappedFile::isMapped() const {
+    return m_impl->isMapped();
+}
+
 Result<> utils::file::createDirectory(std::filesystem::path const& path) {
     std::error_code ec;
 #ifdef GEODE_IS_WINDOWS
@@ -175,12 +502,36 @@ private:
     void* m_stream = nullptr;
     int32_t m_mode;
     std::variant<Path, ByteVector> m_srcDest;
+    // Zips read from disk are mapped and read through a memory stream
+    std::optional<MappedFile> m_mapped;
     std::unordered_map<Path, ZipEntry, path_hash_t> m_entries;
     std::function<void(uint32_t, uint32_t)> m_progressCallback;
 
     Result<> init() {
+        if (std::holds_alternative<Path>(m_srcDest) && m_mode == MZ_OPEN_MODE_READ) {
+            // minizip's memory streams take an int32 length, so zips larger 
+            // than that are read through a file stream instead
+            auto mapped = MappedFile::open(std::get<Path>(m_srcDest));
+            if (mapped && mapped.unwrap().size() <= static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                m_mapped.emplace(std::move(mapped).unwrap());
+            }
+        }
+
+        // open stream from a mapped file
+        if (m_mapped) {
+            m_stream = mz_stream_mem_create();
+            if (!m_stream) {
+                return Err("Unable to create memory stream");
+            }
+            // the buffer is only read from in read mode
+            auto data = m_mapped->data();
+            mz_stream_mem_set_buffer(m_stream, const_cast<uint8_t*>(data.data()), static_cast<int32_t>(data.size()));
+            if (mz_stream_open(m_stream, nullptr, m_mode) != MZ_OK) {
+                return Err("Unable to read memory stream");
+            }
+        }
         // open stream from file
-        if (std::holds_alternative<Path>(m_srcDest)) {
+        else if (std::holds_alternative<Path>(m_srcDest)) {
             auto& path = std::get<Path>(m_srcDest);
             // open file
             m_stream = mz_stream_os_create();
@@ -690,53 +1041,153 @@ Result<> Zip::addFolder(Path const& entry) {
     return m_impl->addFolder(entry);
 }
 
+std::optional<FileIdentity> file::getFileIdentity(std::filesystem::path const& path) {
+#ifdef GEODE_IS_WINDOWS
+    // FILE_FLAG_BACKUP_SEMANTICS is needed to open directories
+    auto handle = CreateFileW(
+        path.wstring().c_str(), 0,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr
+    );
+    if (handle == INVALID_HANDLE_VALUE) {
+        return std::nullopt;
+    }
+    BY_HANDLE_FILE_INFORMATION info;
+    auto success = GetFileInformationByHandle(handle, &info);
+    CloseHandle(handle);
+    if (!success) {
+        return std::nullopt;
+    }
+    return FileIdentity {
+        .device = info.dwVolumeSerialNumber,
+        .file = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow,
+    };
+#else
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return std::nullopt;
+    }
+    return FileIdentity {
+        .device = static_cast<uint64_t>(info.st_dev),
+        .file = static_cast<uint64_t>(info.st_ino),
+    };
+#endif
+}
+
+namespace {
+    struct FileIdentityHash {
+        size_t operator()(FileIdentity const& identity) const noexcept {
+            return std::hash<uint64_t>()(identity.device) ^ (std::hash<uint64_t>()(identity.file) * 31);
+        }
+    };
+}
+
 FileWatchEvent::FileWatchEvent(std::filesystem::path const& path)
-  : m_path(path) {}
+  : m_path(path)
+{
+    if (auto identity = getFileIdentity(path)) {
+        m_identities.push_back(*identity);
+    }
+}
+
+FileWatchEvent::FileWatchEvent(std::filesystem::path const& path, std::vector<FileIdentity> identities)
+  : m_path(path), m_identities(std::move(identities)) {}
 
 std::filesystem::path FileWatchEvent::getPath() const {
     return m_path;
 }
 
+std::vector<FileIdentity> const& FileWatchEvent::getIdentities() const {
+    return m_identities;
+}
+
 ListenerResult FileWatchFilter::handle(
     std::function<Callback> callback,
     FileWatchEvent* event
 ) {
-    std::error_code ec;
-    if (std::filesystem::equivalent(event->getPath(), m_path, ec)) {
+    // Identities were already resolved when the filter and event were 
+    // created, so this doesn't touch the file system. Exact path matches 
+    // still count in case the file has been replaced since this filter was 
+    // created, which gives it a new identity
+    if (
+        (m_identity && ranges::contains(event->getIdentities(), *m_identity)) ||
+        event->getPath() == m_path
+    ) {
         callback(event);
     }
     return ListenerResult::Propagate;
 }
 
 FileWatchFilter::FileWatchFilter(std::filesystem::path const& path) 
-  : m_path(path) {}
+  : m_path(path), m_identity(getFileIdentity(path)) {}
+
+// Keyed by the identity of the file when it started being watched
+static std::unordered_map<FileIdentity, std::unique_ptr<FileWatcher>, FileIdentityHash> FILE_WATCHERS {};
 
-// This is a vector because need to use std::filesystem::equivalent for 
-// comparisons and removal is not exactly performance-critical here
-// (who's going to add and remove 500 file watchers every frame)
-static std::vector<std::unique_ptr<FileWatcher>> FILE_WATCHERS {};
+struct PendingFileWatchEvent {
+    std::filesystem::path path;
+    FileIdentity watchIdentity;
+};
+
+// Changes reported by watcher threads, posted on the main thread together 
+// so a burst of changes only queues one function
+static std::mutex PENDING_FILE_WATCH_EVENTS_MUTEX;
+static std::vector<PendingFileWatchEvent> PENDING_FILE_WATCH_EVENTS;
+
+static void queueFileWatchEvent(std::filesystem::path const& path, FileIdentity const& watchIdentity) {
+    std::lock_guard lock(PENDING_FILE_WATCH_EVENTS_MUTEX);
+    for (auto const& pending : PENDING_FILE_WATCH_EVENTS) {
+        if (pending.watchIdentity == watchIdentity) {
+            return;
+        }
+    }
+    PENDING_FILE_WATCH_EVENTS.push_back({ path, watchIdentity });
+    if (PENDING_FILE_WATCH_EVENTS.size() > 1) {
+        return;
+    }
+    Loader::get()->queueInMainThread([] {
+        std::vector<PendingFileWatchEvent> events;
+        {
+            std::lock_guard lock(PENDING_FILE_WATCH_EVENTS_MUTEX);
+            events.swap(PENDING_FILE_WATCH_EVENTS);
+        }
+        for (auto const& event : events) {
+            std::vector<FileIdentity> identities { event.watchIdentity };
+            if (auto current = getFileIdentity(event.path); current && *current != event.watchIdentity) {
+                identities.push_back(*current);
+            }
+            FileWatchEvent(event.path, std::move(identities)).post();
+        }
+    });
+}
 
 Result<> file::watchFile(std::filesystem::path const& file) {
-    if (!std::filesystem::exists(file)) {
+    auto identity = getFileIdentity(file);
+    if (!identity) {
         return Err("File does not exist");
     }
-    auto watcher = std::make_unique<FileWatcher>(
-        file,
-        [](auto const& path) {
-            Loader::get()->queueInMainThread([=] {
-                FileWatchEvent(path).post();
-            });
-        }
-    );
+    if (FILE_WATCHERS.contains(*identity)) {
+        return Ok();
+    }
+    auto watcher = std::make_unique<FileWatcher>(file, [identity = *identity](auto const& path) {
+        queueFileWatchEvent(path, identity);
+    });
     if (!watcher->watching()) {
         return Err("Unknown error watching file");
     }
-    FILE_WATCHERS.emplace_back(std::move(watcher));
+    FILE_WATCHERS.emplace(*identity, std::move(watcher));
     return Ok();
 }
 
 void file::unwatchFile(std::filesystem::path const& file) {
-    ranges::remove(FILE_WATCHERS, [=](std::unique_ptr<FileWatcher> const& watcher) {
-        return std::filesystem::equivalent(file, watcher->path());
+    if (auto identity = getFileIdentity(file)) {
+        if (FILE_WATCHERS.erase(*identity)) {
+            return;
+        }
+    }
+    // The file may have been replaced or deleted since it started being 
+    // watched, in which case its identity doesn't match anymore
+    std::erase_if(FILE_WATCHERS, [&](auto const& pair) {
+        return pair.second->path() == file;
     });
 }
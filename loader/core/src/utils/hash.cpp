@@ -1,4 +1,5 @@
 #include <Geode/utils/hash.hpp>
+#include <Geode/utils/file.hpp>
 
 // shh, its fine :-)
 #include "hash/sha3.h"
@@ -6,8 +7,8 @@
 #include <string>
 #include <fstream>
 #include <ciso646>
-#include "hash/picosha2.h"
 #include <vector>
+#include <algorithm>
 
 template <class Func>
 void readBuffered(std::ifstream& stream, Func func) {
@@ -24,8 +25,13 @@ void readBuffered(std::ifstream& stream, Func func) {
 }
 
 std::string geode::utils::calculateSHA3_256(std::filesystem::path const& path) {
-    std::ifstream file(path, std::ios::binary);
     SHA3 sha;
+    if (auto mapped = file::MappedFile::open(path)) {
+        auto data = mapped.unwrap().data();
+        sha.add(data.data(), data.size());
+        return sha.getHash();
+    }
+    std::ifstream file(path, std::ios::binary);
     readBuffered(file, [&](const void* data, size_t amt) {
         sha.add(data, amt);
     });
@@ -33,27 +39,49 @@ std::string geode::utils::calculateSHA3_256(std::filesystem::path const& path) {
 }
 
 std::string geode::utils::calculateSHA256(std::filesystem::path const& path) {
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
+    if (auto mapped = file::MappedFile::open(path)) {
+        return calculateHash(mapped.unwrap().data());
+    }
+    SHA256Hasher hasher;
     std::ifstream file(path, std::ios::binary);
-    picosha2::hash256(file, hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    readBuffered(file, [&](const void* data, size_t amt) {
+        hasher.update(std::span(static_cast<const uint8_t*>(data), amt));
+    });
+    return hasher.finishHex();
 }
 
 std::string geode::utils::calculateSHA256Text(std::filesystem::path const& path) {
     // remove all newlines
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
+    SHA256Hasher hasher;
+    if (auto mapped = file::MappedFile::open(path)) {
+        // hash the lines straight from the mapping instead of joining them 
+        // into a string first
+        auto data = mapped.unwrap().data();
+        auto it = data.begin();
+        while (it != data.end()) {
+            auto newline = std::find(it, data.end(), '\n');
+            auto lineEnd = newline;
+#ifdef GEODE_IS_WINDOWS
+            // match reading the file in text mode, which turns CRLF into LF
+            if (newline != data.end() && lineEnd != it && *(lineEnd - 1) == '\r') {
+                --lineEnd;
+            }
+#endif
+            hasher.update(std::span(it, lineEnd));
+            it = newline == data.end() ? newline : newline + 1;
+        }
+        return hasher.finishHex();
+    }
     std::ifstream file(path);
-    std::string text;
     std::string line;
     while (std::getline(file, line)) {
-        text += line;
+        hasher.update(line);
     }
-    picosha2::hash256(text.begin(), text.end(), hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    return hasher.finishHex();
 }
 
 std::string geode::utils::calculateHash(std::span<const uint8_t> data) {
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
-    picosha2::hash256(data.begin(), data.end(), hash);
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    SHA256Hasher hasher;
+    hasher.update(data);
+    return hasher.finishHex();
 }
\ No newline at end of file
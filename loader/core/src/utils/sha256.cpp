@@ -0,0 +1,315 @@
+#include <Geode/utils/hash.hpp>
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define GEODE_SHA256_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    // clang-cl defines _MSC_VER too, but like clang it needs the target 
+    // attribute to use the intrinsics
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define GEODE_SHA256_TARGET
+    #else
+        #define GEODE_SHA256_TARGET __attribute__((target("sha,sse4.1")))
+    #endif
+#elif defined(__aarch64__)
+    #define GEODE_SHA256_ARM
+    #include <arm_neon.h>
+    #if defined(__clang__)
+        #define GEODE_SHA256_TARGET __attribute__((target("crypto")))
+    #else
+        #define GEODE_SHA256_TARGET __attribute__((target("+crypto")))
+    #endif
+    #if defined(__linux__) || defined(__ANDROID__)
+        #include <sys/auxv.h>
+        #include <asm/hwcap.h>
+    #endif
+#endif
+
+using geode::utils::SHA256Hasher;
+
+namespace {
+    constexpr uint32_t ROUND_CONSTANTS[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+    };
+
+    constexpr uint32_t INITIAL_STATE[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+
+    using CompressFn = void(*)(uint32_t* state, const uint8_t* blocks, size_t count);
+
+    uint32_t loadBigEndian(const uint8_t* data) {
+        return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+    }
+
+    void compressScalar(uint32_t* state, const uint8_t* blocks, size_t count) {
+        for (; count > 0; count -= 1, blocks += 64) {
+            uint32_t w[64];
+            for (size_t i = 0; i < 16; i++) {
+                w[i] = loadBigEndian(blocks + i * 4);
+            }
+            for (size_t i = 16; i < 64; i++) {
+                auto s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                auto s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            auto a = state[0], b = state[1], c = state[2], d = state[3];
+            auto e = state[4], f = state[5], g = state[6], h = state[7];
+            for (size_t i = 0; i < 64; i++) {
+                auto s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+                auto ch = (e & f) ^ (~e & g);
+                auto t1 = h + s1 + ch + ROUND_CONSTANTS[i] + w[i];
+                auto s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+                auto maj = (a & b) ^ (a & c) ^ (b & c);
+                auto t2 = s0 + maj;
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    }
+
+#ifdef GEODE_SHA256_X86
+    bool hasSHAExtensions() {
+        // SHA-NI, plus SSSE3 and SSE4.1 for the shuffles and blends around it
+        uint32_t ecx1, ebx7;
+    #ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        ecx1 = info[2];
+        __cpuidex(info, 7, 0);
+        ebx7 = info[1];
+    #else
+        uint32_t eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+        ecx1 = ecx;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+        ebx7 = ebx;
+    #endif
+        bool ssse3 = ecx1 & (1 << 9);
+        bool sse41 = ecx1 & (1 << 19);
+        bool sha = ebx7 & (1 << 29);
+        return ssse3 && sse41 && sha;
+    }
+
+    GEODE_SHA256_TARGET void compressSHANI(uint32_t* state, const uint8_t* blocks, size_t count) {
+        auto const shuffleMask = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+        auto const k = reinterpret_cast<const __m128i*>(ROUND_CONSTANTS);
+
+        // The instructions want the state as ABEF and CDGH
+        auto tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+        auto state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);       // CDAB
+        state1 = _mm_shuffle_epi32(state1, 0x1B); // EFGH
+        auto state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);   // CDGH
+
+        for (; count > 0; count -= 1, blocks += 64) {
+            auto const abefSave = state0;
+            auto const cdghSave = state1;
+
+            __m128i msgs[4];
+            for (size_t i = 0; i < 4; i++) {
+                msgs[i] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + i * 16)), shuffleMask
+                );
+            }
+
+            // 16 groups of 4 rounds; the message schedule for the next groups
+            // is computed alongside
+            for (size_t i = 0; i < 16; i++) {
+                auto& cur = msgs[i % 4];
+                auto msg = _mm_add_epi32(cur, _mm_loadu_si128(k + i));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+                if (i >= 3 && i < 15) {
+                    auto& next = msgs[(i + 1) % 4];
+                    auto t = _mm_alignr_epi8(cur, msgs[(i + 3) % 4], 4);
+                    next = _mm_add_epi32(next, t);
+                    next = _mm_sha256msg2_epu32(next, cur);
+                }
+                msg = _mm_shuffle_epi32(msg, 0x0E);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+                if (i >= 1 && i < 13) {
+                    msgs[(i + 3) % 4] = _mm_sha256msg1_epu32(msgs[(i + 3) % 4], cur);
+                }
+            }
+
+            state0 = _mm_add_epi32(state0, abefSave);
+            state1 = _mm_add_epi32(state1, cdghSave);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+        state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+        state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+        state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+    }
+#endif
+
+#ifdef GEODE_SHA256_ARM
+    bool hasSHAExtensions() {
+    #if defined(__APPLE__)
+        // Every ARM Mac and iOS device that can run the game has them
+        return true;
+    #elif defined(__linux__) || defined(__ANDROID__)
+        return getauxval(AT_HWCAP) & HWCAP_SHA2;
+    #else
+        return false;
+    #endif
+    }
+
+    GEODE_SHA256_TARGET void compressARM(uint32_t* state, const uint8_t* blocks, size_t count) {
+        auto state0 = vld1q_u32(state);
+        auto state1 = vld1q_u32(state + 4);
+
+        for (; count > 0; count -= 1, blocks += 64) {
+            auto const abcdSave = state0;
+            auto const efghSave = state1;
+
+            uint32x4_t msgs[4];
+            for (size_t i = 0; i < 4; i++) {
+                msgs[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + i * 16)));
+            }
+
+            // 16 groups of 4 rounds; the message schedule for the next groups
+            // is computed alongside
+            for (size_t i = 0; i < 16; i++) {
+                auto& cur = msgs[i % 4];
+                auto msg = vaddq_u32(cur, vld1q_u32(ROUND_CONSTANTS + i * 4));
+                if (i < 12) {
+                    cur = vsha256su1q_u32(
+                        vsha256su0q_u32(cur, msgs[(i + 1) % 4]), msgs[(i + 2) % 4], msgs[(i + 3) % 4]
+                    );
+                }
+                auto abcd = state0;
+                state0 = vsha256hq_u32(state0, state1, msg);
+                state1 = vsha256h2q_u32(state1, abcd, msg);
+            }
+
+            state0 = vaddq_u32(state0, abcdSave);
+            state1 = vaddq_u32(state1, efghSave);
+        }
+
+        vst1q_u32(state, state0);
+        vst1q_u32(state + 4, state1);
+    }
+#endif
+
+    CompressFn selectCompress() {
+#if defined(GEODE_SHA256_X86)
+        if (hasSHAExtensions()) return &compressSHANI;
+#elif defined(GEODE_SHA256_ARM)
+        if (hasSHAExtensions()) return &compressARM;
+#endif
+        return &compressScalar;
+    }
+
+    // The CPU is only checked once
+    CompressFn const COMPRESS = selectCompress();
+}
+
+SHA256Hasher::SHA256Hasher() {
+    this->reset();
+}
+
+void SHA256Hasher::reset() {
+    std::memcpy(m_state, INITIAL_STATE, sizeof(m_state));
+    m_bufferSize = 0;
+    m_length = 0;
+}
+
+void SHA256Hasher::update(std::span<const uint8_t> data) {
+    auto ptr = data.data();
+    auto size = data.size();
+    m_length += size;
+
+    // Finish the block left over from the last update first
+    if (m_bufferSize > 0) {
+        auto take = std::min(size, sizeof(m_buffer) - m_bufferSize);
+        std::memcpy(m_buffer + m_bufferSize, ptr, take);
+        m_bufferSize += take;
+        ptr += take;
+        size -= take;
+        if (m_bufferSize < sizeof(m_buffer)) {
+            return;
+        }
+        COMPRESS(m_state, m_buffer, 1);
+        m_bufferSize = 0;
+    }
+
+    // Hash whole blocks straight from the input
+    if (auto blocks = size / 64) {
+        COMPRESS(m_state, ptr, blocks);
+        ptr += blocks * 64;
+        size -= blocks * 64;
+    }
+
+    if (size > 0) {
+        std::memcpy(m_buffer, ptr, size);
+        m_bufferSize = size;
+    }
+}
+
+void SHA256Hasher::update(std::string_view data) {
+    this->update(std::span(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+}
+
+std::array<uint8_t, 32> SHA256Hasher::finish() {
+    auto const bitLength = m_length * 8;
+
+    // Padding is a single 1 bit, zeroes up to 8 bytes before the end of a
+    // block, and then the message length in bits
+    uint8_t padding[72] = { 0x80 };
+    auto padSize = (m_bufferSize < 56 ? 56 : 120) - m_bufferSize;
+    for (size_t i = 0; i < 8; i++) {
+        padding[padSize + i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    this->update(std::span<const uint8_t>(padding, padSize + 8));
+
+    std::array<uint8_t, 32> digest;
+    for (size_t i = 0; i < 8; i++) {
+        digest[i * 4 + 0] = static_cast<uint8_t>(m_state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(m_state[i]);
+    }
+    this->reset();
+    return digest;
+}
+
+std::string SHA256Hasher::finishHex() {
+    constexpr auto DIGITS = "0123456789abcdef";
+    auto digest = this->finish();
+    std::string hex;
+    hex.reserve(digest.size() * 2);
+    for (auto byte : digest) {
+        hex.push_back(DIGITS[byte >> 4]);
+        hex.push_back(DIGITS[byte & 0xf]);
+    }
+    return hex;
+}
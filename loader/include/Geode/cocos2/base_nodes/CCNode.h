@@ -43,6 +43,7 @@
 namespace geode {
     class Layout;
     class LayoutOptions;
+    enum class LayoutUpdateMode;
     enum class Anchor;
 }
 
@@ -1002,6 +1003,19 @@ public:
      * @note Geode addition
      */
     GEODE_DLL void updateLayout(bool updateChildOrder = true);
+    /**
+     * Set when updateLayout applies this node's layout. In deferred mode, 
+     * updateLayout only marks the node as dirty and the layout is applied 
+     * once right before the next frame is drawn
+     * @param mode The update mode; the default is LayoutUpdateMode::Immediate
+     * @note Geode addition
+     */
+    GEODE_DLL void setLayoutUpdateMode(geode::LayoutUpdateMode mode);
+    /**
+     * Get when updateLayout applies this node's layout
+     * @note Geode addition
+     */
+    GEODE_DLL geode::LayoutUpdateMode getLayoutUpdateMode();
     /**
      * Set the layout options for this node. Layout options can be used to 
      * control how this node is positioned in its parent's Layout, for example 
@@ -49,6 +49,26 @@ public:
     virtual ~LayoutOptions() = default;
 };
 
+/**
+ * Controls when CCNode::updateLayout applies a node's layout
+ */
+enum class LayoutUpdateMode {
+    // The layout is applied right away (default)
+    Immediate,
+    // The node is only marked as needing a layout update, and all marked 
+    // nodes are laid out once right before the next frame is drawn, innermost 
+    // nodes first. Calling updateLayout many times in a row (for example 
+    // after adding every button to a menu) then only lays the node out once
+    Deferred,
+};
+
+/**
+ * Lay out every node with a pending deferred layout update right now, 
+ * innermost nodes first. Useful if you need the final positions or sizes of 
+ * nodes that use LayoutUpdateMode::Deferred before the next frame
+ */
+GEODE_DLL void applyDeferredLayouts();
+
 /**
  * The direction of an AxisLayout
  */
@@ -2,6 +2,9 @@
 
 #include <Geode/binding/CCContentLayer.hpp>
 #include <Geode/binding/CCScrollLayerExt.hpp>
+#include <Geode/utils/cocos.hpp>
+#include <functional>
+#include <map>
 
 namespace geode {
     /**
@@ -38,4 +41,72 @@ namespace geode {
         void enableScrollWheel(bool enable = true);
         void scrollToTop();
     };
+
+    /**
+     * A vertical ScrollLayer for long lists of same-sized cells. Rather than 
+     * creating a node for every item up front, cells only exist for the items 
+     * in view (plus a few rows of overscan), and cells that scroll out of 
+     * view are reused for the items scrolling into view
+     */
+    class GEODE_DLL RecyclingScrollLayer : public ScrollLayer {
+    public:
+        /// Creates a new cell for the item at the given index
+        using CreateCell = std::function<cocos2d::CCNode*(size_t index)>;
+        /// Binds the item at the given index to a previously used cell
+        using BindCell = std::function<void(cocos2d::CCNode* cell, size_t index)>;
+
+    protected:
+        CreateCell m_createCell;
+        BindCell m_bindCell;
+        size_t m_itemCount = 0;
+        cocos2d::CCSize m_cellSize = { 0, 0 };
+        size_t m_columns = 1;
+        float m_gap = 0;
+        size_t m_overscan = 2;
+        std::map<size_t, Ref<cocos2d::CCNode>> m_activeCells;
+        std::vector<Ref<cocos2d::CCNode>> m_unusedCells;
+        // The [first, last) range of items that currently have cells
+        std::pair<size_t, size_t> m_cellRange = { 0, 0 };
+        bool m_positionsDirty = false;
+
+        RecyclingScrollLayer(cocos2d::CCRect const& rect, bool scrollWheelEnabled, CreateCell&& createCell, BindCell&& bindCell);
+
+        size_t getRowCount() const;
+        void positionCell(cocos2d::CCNode* cell, size_t index);
+        void updateContentHeight();
+        void updateCells(bool rebind);
+        void removeAllCells();
+
+        void visit() override;
+
+    public:
+        static RecyclingScrollLayer* create(
+            cocos2d::CCSize const& size, CreateCell createCell, BindCell bindCell,
+            bool scrollWheelEnabled = true
+        );
+
+        void setContentSize(cocos2d::CCSize const& size) override;
+
+        /**
+         * Set the size of every cell and how many are placed on each row. 
+         * Changing these discards all existing cells
+         */
+        void setCellSize(cocos2d::CCSize const& size, size_t columns = 1, float gap = 0);
+        /**
+         * Set how many rows of cells above and below the visible area are kept 
+         * around, so they don't have to be bound the moment they scroll in
+         */
+        void setOverscan(size_t rows);
+        /**
+         * Set the number of items in the list and rebind all cells
+         */
+        void reloadData(size_t itemCount);
+        size_t getItemCount() const;
+        /**
+         * Get the cell currently bound to the item at the given index, or null 
+         * if that item has no cell (because it's out of view)
+         */
+        cocos2d::CCNode* getCell(size_t index) const;
+        std::vector<cocos2d::CCNode*> getActiveCells() const;
+    };
 }
@@ -4,6 +4,7 @@
 #include <Geode/loader/Log.hpp>
 #include <Geode/binding/CCMenuItemSpriteExtra.hpp>
 #include <Geode/binding/CCMenuItemToggler.hpp>
+#include <span>
 
 using namespace geode::prelude;
 
@@ -91,6 +92,59 @@ static AxisAlignment optsCrossAxisAlign(AxisLayoutOptions const* opts, AxisAlign
     return def;
 }
 
+// Cheap hash of everything that affects the result of an AxisLayout, used to 
+// skip relayouting when nothing has changed
+class LayoutFingerprint final {
+    uint64_t m_hash = 0xcbf29ce484222325;
+
+public:
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    void add(T const& value) {
+        auto bytes = reinterpret_cast<uint8_t const*>(&value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            m_hash ^= bytes[i];
+            m_hash *= 0x100000001b3;
+        }
+    }
+    template <class T>
+    void add(std::optional<T> const& value) {
+        this->add(value.has_value());
+        if (value) {
+            this->add(*value);
+        }
+    }
+    void add(CCSize const& size) {
+        this->add(size.width);
+        this->add(size.height);
+    }
+    void add(CCPoint const& point) {
+        this->add(point.x);
+        this->add(point.y);
+    }
+    void add(AxisLayoutOptions const* opts) {
+        this->add(opts != nullptr);
+        if (!opts) return;
+        this->add(opts->getAutoScale());
+        this->add(opts->hasExplicitMinScale());
+        this->add(opts->hasExplicitMaxScale());
+        this->add(opts->getMinScale());
+        this->add(opts->getMaxScale());
+        this->add(opts->getRelativeScale());
+        this->add(opts->getLength());
+        this->add(opts->getPrevGap());
+        this->add(opts->getNextGap());
+        this->add(opts->getBreakLine());
+        this->add(opts->getSameLine());
+        this->add(opts->getScalePriority());
+        this->add(opts->getCrossAxisAlignment());
+    }
+
+    uint64_t value() const {
+        return m_hash;
+    }
+};
+
 struct AxisPosition {
     float axisLength;
     float axisAnchor;
@@ -142,7 +196,19 @@ public:
     std::optional<float> m_autoGrowAxisMinLength;
     std::pair<float, float> m_defaultScaleLimits = { AXISLAYOUT_DEFAULT_MIN_SCALE, 1 };
 
-    struct Row : public CCObject {
+    // The result of the last layout, reapplied directly if the fingerprint 
+    // of the node being laid out still matches. Only one node is remembered 
+    // since layouts are almost never shared between nodes
+    struct CachedLayout {
+        CCNode* on = nullptr;
+        uint64_t fingerprint = 0;
+        std::vector<std::pair<CCNode*, CCPoint>> positions;
+    };
+    std::optional<CachedLayout> m_cache;
+
+    uint64_t fingerprint(CCNode* on, std::span<CCNode* const> nodes) const;
+
+    struct Row {
         float nextOverflowScaleDownFactor;
         float nextOverflowSquishFactor;
         float axisLength;
@@ -150,7 +216,7 @@ public:
         float axisEndsLength;
 
         // all layout calculations happen within a single frame so no Ref needed
-        CCArray* nodes;
+        std::vector<CCNode*> nodes;
 
         // calculated values for scale, squish and prio to fit the nodes in this 
         // row when positioning
@@ -158,32 +224,9 @@ public:
         float squish;
         float prio;
 
-        Row(
-            float scaleFactor,
-            float squishFactor,
-            float axisLength,
-            float crossLength,
-            float axisEndsLength,
-            CCArray* nodes,
-            float scale,
-            float squish,
-            float prio
-        ) : nextOverflowScaleDownFactor(scaleFactor),
-            nextOverflowSquishFactor(squishFactor),
-            axisLength(axisLength),
-            crossLength(crossLength),
-            axisEndsLength(axisEndsLength),
-            nodes(nodes),
-            scale(scale),
-            squish(squish),
-            prio(prio)
-        {
-            this->autorelease();
-        }
-
         void accountSpacers(Axis axis, float availableLength, float crossLength) {
             std::vector<SpacerNode*> spacers;
-            for (auto& node : CCArrayExt<CCNode*>(nodes)) {
+            for (auto& node : nodes) {
                 if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
                     spacers.push_back(spacer);
                 }
@@ -208,10 +251,10 @@ public:
         }
     };
     
-    float minScaleForPrio(CCArray* nodes, int prio) const {
+    float minScaleForPrio(std::span<CCNode* const> nodes, int prio) const {
         float min = m_defaultScaleLimits.first;
         bool first = true;
-        for (auto node : CCArrayExt<CCNode*>(nodes)) {
+        for (auto node : nodes) {
             auto scale = optsMinScale(axisOpts(node), m_defaultScaleLimits.first);
             if (first) {
                 min = scale;
@@ -224,10 +267,10 @@ public:
         return min;
     }
 
-    float maxScaleForPrio(CCArray* nodes, int prio) const {
+    float maxScaleForPrio(std::span<CCNode* const> nodes, int prio) const {
         float max = m_defaultScaleLimits.second;
         bool first = true;
-        for (auto node : CCArrayExt<CCNode*>(nodes)) {
+        for (auto node : nodes) {
             auto scale = optsMaxScale(axisOpts(node), m_defaultScaleLimits.second);
             if (first) {
                 max = scale;
@@ -250,7 +293,7 @@ public:
     }
 
     bool canTryScalingDown(
-        CCArray* nodes,
+        std::span<CCNode* const> nodes,
         int& prio, float& scale,
         float crossScaleDownFactor,
         std::pair<int, int> const& minMaxPrios
@@ -302,8 +345,8 @@ public:
         return gap.value_or(ix ? m_gap : 0);
     }
 
-    Row* fitInRow(
-        CCNode* on, CCArray* nodes,
+    Row fitInRow(
+        CCNode* on, std::span<CCNode* const> nodes,
         std::pair<int, int> const& minMaxPrios,
         bool doAutoScale,
         float scale, float squish, int prio
@@ -313,11 +356,13 @@ public:
         float axisUnsquishedLength;
         float axisLength;
         float crossLength;
-        auto res = CCArray::create();
+        std::vector<CCNode*> res;
 
         auto available = nodeAxis(on, m_axis, 1.f / on->getScale());
 
-        auto fit = [&](CCArray* nodes) {
+        // when collecting, the nodes that fit in this row are added to res; 
+        // otherwise the nodes already in res are refitted
+        auto fit = [&](std::span<CCNode* const> nodes, bool collect) {
             nextAxisScalableLength = 0.f;
             nextAxisUnscalableLength = 0.f;
             axisUnsquishedLength = 0.f;
@@ -325,7 +370,7 @@ public:
             crossLength = 0.f;
             AxisLayoutOptions const* prev = nullptr;
             size_t ix = 0;
-            for (auto& node : CCArrayExt<CCNode*>(nodes)) {
+            for (auto& node : nodes) {
                 auto opts = axisOpts(node);
                 if (this->shouldAutoScale(opts)) {
                     node->setScale(1.f);
@@ -351,8 +396,8 @@ public:
                 ) {
                     break;
                 }
-                if (nodes != res) {
-                    res->addObject(node);
+                if (collect) {
+                    res.push_back(node);
                 }
                 if (ix) {
                     auto gap = nextGap(prev, opts, ix);
@@ -382,12 +427,7 @@ public:
             }
         };
 
-        fit(nodes);
-
-        // whoops! removing objects from a CCArray while iterating is totes potes UB
-        for (int i = 0; i < res->count(); i++) {
-            nodes->removeFirstObject();
-        }
+        fit(nodes, true);
 
         // todo: make this calculation more smart to avoid so much unnecessary recursion
         auto scaleDownFactor = scale - .002f;
@@ -402,7 +442,7 @@ public:
             else {
                 squish = available.axisLength / axisUnsquishedLength;
             }
-            fit(res);
+            fit(res, false);
             // Avoid infinite loops
             if (tries-- <= 0) {
                 break;
@@ -411,13 +451,13 @@ public:
 
         // reverse row if needed
         if (m_axisReverse) {
-            res->reverseObjects();
+            std::reverse(res.begin(), res.end());
         }
 
         float axisEndsLength = 0.f;
-        if (res->count()) {
-            auto first = static_cast<CCNode*>(res->firstObject());
-            auto last = static_cast<CCNode*>(res->lastObject());
+        if (res.size()) {
+            auto first = res.front();
+            auto last = res.back();
             axisEndsLength = (
                 first->getScaledContentSize().width * 
                     scaleByOpts(axisOpts(first), scale, prio, false, m_defaultScaleLimits.first, m_defaultScaleLimits.second) / 2 +
@@ -426,23 +466,27 @@ public:
             );
         }
 
-        return new Row(
+        return Row {
             // how much should the nodes be scaled down to fit the next row
             // the .01f is because floating point arithmetic is imprecise and you 
             // end up in a situation where it confidently tells you that
             // 241 > 241 == true
-            scaleDownFactor,
+            .nextOverflowScaleDownFactor = scaleDownFactor,
             // how much should the nodes be squished to fit the next item in this 
             // row
-            squishFactor,
-            axisLength, crossLength, axisEndsLength,
-            res,
-            scale, squish, prio
-        );
+            .nextOverflowSquishFactor = squishFactor,
+            .axisLength = axisLength,
+            .crossLength = crossLength,
+            .axisEndsLength = axisEndsLength,
+            .nodes = std::move(res),
+            .scale = scale,
+            .squish = squish,
+            .prio = static_cast<float>(prio),
+        };
     }
 
     void tryFitLayout(
-        CCNode* on, CCArray* nodes,
+        CCNode* on, std::span<CCNode* const> nodes,
         std::pair<int, int> const& minMaxPrios,
         bool doAutoScale,
         float scale, float squish, int prio,
@@ -453,14 +497,14 @@ public:
         // like i genuinely have no clue fr why some of these work tho, 
         // i just threw in random equations and numbers until it worked
 
-        auto rows = CCArray::create();
+        std::vector<Row> rows;
         float maxRowAxisLength = 0.f;
         float totalRowCrossLength = 0.f;
         float crossScaleDownFactor = 0.f;
         float crossSquishFactor = 0.f;
 
         // make spacers have zero size so they don't affect spacing calculations
-        for (auto& node : CCArrayExt<CCNode*>(nodes)) {
+        for (auto& node : nodes) {
             if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
                 spacer->setContentSize(CCSizeZero);
             }
@@ -468,38 +512,37 @@ public:
         
         // fit everything into rows while possible
         size_t ix = 0;
-        auto newNodes = nodes->shallowCopy();
-        while (newNodes->count()) {
-            auto row = this->fitInRow(
-                on, newNodes,
+        size_t fitted = 0;
+        while (fitted < nodes.size()) {
+            auto& row = rows.emplace_back(this->fitInRow(
+                on, nodes.subspan(fitted),
                 minMaxPrios, doAutoScale,
                 scale, squish, prio
-            );
-            rows->addObject(row);
+            ));
+            fitted += row.nodes.size();
             if (
-                row->nextOverflowScaleDownFactor > crossScaleDownFactor &&
-                row->nextOverflowScaleDownFactor < scale
+                row.nextOverflowScaleDownFactor > crossScaleDownFactor &&
+                row.nextOverflowScaleDownFactor < scale
             ) {
-                crossScaleDownFactor = row->nextOverflowScaleDownFactor;
+                crossScaleDownFactor = row.nextOverflowScaleDownFactor;
             }
             if (
-                row->nextOverflowSquishFactor > crossSquishFactor &&
-                row->nextOverflowSquishFactor < squish
+                row.nextOverflowSquishFactor > crossSquishFactor &&
+                row.nextOverflowSquishFactor < squish
             ) {
-                crossSquishFactor = row->nextOverflowSquishFactor;
+                crossSquishFactor = row.nextOverflowSquishFactor;
             }
-            totalRowCrossLength += row->crossLength;
+            totalRowCrossLength += row.crossLength;
             if (ix) {
                 totalRowCrossLength += m_gap;
             }
-            if (row->axisLength > maxRowAxisLength) {
-                maxRowAxisLength = row->axisLength;
+            if (row.axisLength > maxRowAxisLength) {
+                maxRowAxisLength = row.axisLength;
             }
             ix++;
         }
-        newNodes->release();
 
-        if (!rows->count()) {
+        if (rows.empty()) {
             return;
         }
 
@@ -518,7 +561,6 @@ public:
             depth < RECURSION_DEPTH_LIMIT
         ) {
             if (this->canTryScalingDown(nodes, prio, scale, crossScaleDownFactor, minMaxPrios)) {
-                rows->release();
                 return this->tryFitLayout(
                     on, nodes,
                     minMaxPrios, doAutoScale,
@@ -540,7 +582,6 @@ public:
                 !m_growCrossAxis ||
                 totalRowCrossLength / available.crossLength < crossSquishFactor
             ) {
-                rows->release();
                 return this->tryFitLayout(
                     on, nodes,
                     minMaxPrios, doAutoScale,
@@ -553,7 +594,7 @@ public:
         // if we're here, the nodes are ready to be positioned
 
         if (m_crossReverse) {
-            rows->reverseObjects();
+            std::reverse(rows.begin(), rows.end());
         }
 
         // resize cross axis if needed
@@ -580,10 +621,8 @@ public:
         }
 
         float rowsEndsLength = 0.f;
-        if (rows->count()) {
-            auto first = static_cast<Row*>(rows->firstObject());
-            auto last = static_cast<Row*>(rows->lastObject());
-            rowsEndsLength = first->crossLength / 2 + last->crossLength / 2;
+        if (rows.size()) {
+            rowsEndsLength = rows.front().crossLength / 2 + rows.back().crossLength / 2;
         }
 
         float rowCrossPos;
@@ -609,27 +648,27 @@ public:
             } break;
         }
 
-        float rowEvenSpace = available.crossLength / rows->count();
+        float rowEvenSpace = available.crossLength / rows.size();
         
         float rowCrossLengthTotal = ranges::reduce<float>(
-            CCArrayExt<Row*>(rows),
-            [](float& acc, Row* row) {
-                acc += row->crossLength;
+            rows,
+            [](float& acc, Row const& row) {
+                acc += row.crossLength;
             }
         );
-        float rowCrossBetweenSpace = std::max(0.f, (available.crossLength - rowCrossLengthTotal) / std::max(rows->count() - 1, 1u));
+        float rowCrossBetweenSpace = std::max(0.f, (available.crossLength - rowCrossLengthTotal) / std::max<size_t>(rows.size() - 1, 1));
 
-        for (auto row : CCArrayExt<Row*>(rows)) {
-            row->accountSpacers(m_axis, available.axisLength, available.crossLength);
+        for (auto& row : rows) {
+            row.accountSpacers(m_axis, available.axisLength, available.crossLength);
 
             if (m_crossAlignment == AxisAlignment::Even) {
-                rowCrossPos -= rowEvenSpace / 2 + row->crossLength / 2;
+                rowCrossPos -= rowEvenSpace / 2 + row.crossLength / 2;
             }
             else if (m_crossAlignment == AxisAlignment::Between) {
-                rowCrossPos -= row->crossLength * columnSquish;
+                rowCrossPos -= row.crossLength * columnSquish;
             }
             else {
-                rowCrossPos -= row->crossLength * columnSquish;
+                rowCrossPos -= row.crossLength * columnSquish;
             }
 
             // starting axis pos
@@ -642,46 +681,46 @@ public:
                 } break;
 
                 case AxisAlignment::Center: {
-                    rowAxisPos = available.axisLength / 2 - row->axisLength / 2;
+                    rowAxisPos = available.axisLength / 2 - row.axisLength / 2;
                 } break;
 
                 case AxisAlignment::End: {
-                    rowAxisPos = available.axisLength - row->axisLength;
+                    rowAxisPos = available.axisLength - row.axisLength;
                 } break;
             }
 
             float rowLengthTotal = 0.f;
-            for (auto& node : CCArrayExt<CCNode*>(row->nodes)) {
+            for (auto& node : row.nodes) {
                 auto opts = axisOpts(node);
                 // rescale node if overflowing
                 // do not scale spacers since that screws up their content size
                 if (this->shouldAutoScale(opts) && !typeinfo_cast<SpacerNode*>(node)) {
-                    auto nodeScale = scaleByOpts(opts, row->scale, row->prio, false, m_defaultScaleLimits.first, m_defaultScaleLimits.second);
+                    auto nodeScale = scaleByOpts(opts, row.scale, row.prio, false, m_defaultScaleLimits.first, m_defaultScaleLimits.second);
                     // CCMenuItemSpriteExtra is quirky af
                     if (auto btn = typeinfo_cast<CCMenuItemSpriteExtra*>(node)) {
                         btn->m_baseScale = nodeScale;
                     }
                     node->setScale(nodeScale);
                 }
-                auto pos = nodeAxis(node, m_axis, row->squish);
+                auto pos = nodeAxis(node, m_axis, row.squish);
                 rowLengthTotal += pos.axisLength;
             }
-            float evenSpace = available.axisLength / row->nodes->count();
-            float rowBetweenSpace = std::max(0.f, (available.axisLength - rowLengthTotal) / std::max(row->nodes->count() - 1, 1u));
+            float evenSpace = available.axisLength / row.nodes.size();
+            float rowBetweenSpace = std::max(0.f, (available.axisLength - rowLengthTotal) / std::max<size_t>(row.nodes.size() - 1, 1));
 
             size_t ix = 0;
             AxisLayoutOptions const* prev = nullptr;
-            for (auto& node : CCArrayExt<CCNode*>(row->nodes)) {
+            for (auto& node : row.nodes) {
                 auto opts = axisOpts(node);
                 if (ix == 0) {
-                    rowAxisPos += row->axisEndsLength * row->scale / 2 * (1.f - row->squish);
+                    rowAxisPos += row.axisEndsLength * row.scale / 2 * (1.f - row.squish);
                 }
-                auto pos = nodeAxis(node, m_axis, row->squish);
+                auto pos = nodeAxis(node, m_axis, row.squish);
                 float axisPos;
                 if (m_axisAlignment == AxisAlignment::Even) {
                     axisPos = rowAxisPos + evenSpace / 2 - pos.axisLength * (.5f - pos.axisAnchor);
                     rowAxisPos += evenSpace - 
-                        row->axisEndsLength * row->scale * (1.f - row->squish) * 1.f / nodes->count();
+                        row.axisEndsLength * row.scale * (1.f - row.squish) * 1.f / nodes.size();
                 }
                 else if (m_axisAlignment == AxisAlignment::Between) {
                     axisPos = rowAxisPos + pos.axisLength * pos.axisAnchor;
@@ -689,16 +728,16 @@ public:
                 }
                 else {
                     if (ix != 0) {
-                        if (row->prio == minMaxPrios.first) {
-                            rowAxisPos += this->nextGap(prev, opts, ix) * row->scale * row->squish;
+                        if (row.prio == minMaxPrios.first) {
+                            rowAxisPos += this->nextGap(prev, opts, ix) * row.scale * row.squish;
                         }
                         else {
-                            rowAxisPos += this->nextGap(prev, opts, ix) * row->squish;
+                            rowAxisPos += this->nextGap(prev, opts, ix) * row.squish;
                         }
                     }
                     axisPos = rowAxisPos + pos.axisLength * pos.axisAnchor;
                     rowAxisPos += pos.axisLength - 
-                        row->axisEndsLength * row->scale * (1.f - row->squish) * 1.f / nodes->count();
+                        row.axisEndsLength * row.scale * (1.f - row.squish) * 1.f / nodes.size();
                 }
                 float crossOffset;
                 switch (optsCrossAxisAlign(opts, m_crossLineAlignment)) {
@@ -709,11 +748,11 @@ public:
                     case AxisAlignment::Center:
                     case AxisAlignment::Between:
                     case AxisAlignment::Even: {
-                        crossOffset = row->crossLength / 2 - pos.crossLength * (.5f - pos.crossAnchor);
+                        crossOffset = row.crossLength / 2 - pos.crossLength * (.5f - pos.crossAnchor);
                     } break;
 
                     case AxisAlignment::End: {
-                        crossOffset = row->crossLength - pos.crossLength * (1.f - pos.crossAnchor);
+                        crossOffset = row.crossLength - pos.crossLength * (1.f - pos.crossAnchor);
                     } break;
                 }
                 if (m_axis == Axis::Row) {
@@ -727,24 +766,76 @@ public:
             }
         
             if (m_crossAlignment == AxisAlignment::Even) {
-                rowCrossPos -= rowEvenSpace / 2 - row->crossLength / 2 - 
-                    rowsEndsLength * 1.5f * row->scale * (1.f - columnSquish) * 1.f / rows->count();
+                rowCrossPos -= rowEvenSpace / 2 - row.crossLength / 2 - 
+                    rowsEndsLength * 1.5f * row.scale * (1.f - columnSquish) * 1.f / rows.size();
             }
             else if (m_crossAlignment == AxisAlignment::Between) {
                 rowCrossPos -= rowCrossBetweenSpace -
-                    rowsEndsLength * 1.5f * row->scale * (1.f - columnSquish) * 1.f / rows->count();
+                    rowsEndsLength * 1.5f * row.scale * (1.f - columnSquish) * 1.f / rows.size();
             }
             else {
                 rowCrossPos -= m_gap * columnSquish - 
-                    rowsEndsLength * 1.5f * row->scale * (1.f - columnSquish) * 1.f / rows->count();
+                    rowsEndsLength * 1.5f * row.scale * (1.f - columnSquish) * 1.f / rows.size();
             }
         }
     }
 };
 
+uint64_t AxisLayout::Impl::fingerprint(CCNode* on, std::span<CCNode* const> nodes) const {
+    LayoutFingerprint fingerprint;
+    fingerprint.add(m_axis);
+    fingerprint.add(m_axisAlignment);
+    fingerprint.add(m_crossAlignment);
+    fingerprint.add(m_crossLineAlignment);
+    fingerprint.add(m_gap);
+    fingerprint.add(m_autoScale);
+    fingerprint.add(m_axisReverse);
+    fingerprint.add(m_crossReverse);
+    fingerprint.add(m_allowCrossAxisOverflow);
+    fingerprint.add(m_growCrossAxis);
+    fingerprint.add(m_autoGrowAxisMinLength);
+    fingerprint.add(m_defaultScaleLimits.first);
+    fingerprint.add(m_defaultScaleLimits.second);
+    fingerprint.add(on->getContentSize());
+    fingerprint.add(on->getScale());
+    for (auto node : nodes) {
+        fingerprint.add(node);
+        fingerprint.add(node->getContentSize());
+        fingerprint.add(node->getAnchorPoint());
+        fingerprint.add(node->getScaleX());
+        fingerprint.add(node->getScaleY());
+        fingerprint.add(node->isIgnoreAnchorPointForPosition());
+        fingerprint.add(axisOpts(node));
+        // spacers are resized by the layout, so their size doesn't change
+        // when their grow factor does
+        if (auto spacer = typeinfo_cast<SpacerNode*>(node)) {
+            fingerprint.add(spacer->getGrow());
+        }
+    }
+    return fingerprint.value();
+}
+
 void AxisLayout::apply(CCNode* on) {
-    auto nodes = getNodesToPosition(on);
-    
+    auto nodesArray = getNodesToPosition(on);
+    std::vector<CCNode*> nodes;
+    nodes.reserve(nodesArray->count());
+    for (auto node : CCArrayExt<CCNode*>(nodesArray)) {
+        nodes.push_back(node);
+    }
+
+    // The fingerprint is taken from what the nodes look like after being laid 
+    // out, so if nothing has been changed since the last layout it matches 
+    // and only the positions need to be restored
+    if (m_impl->m_cache && m_impl->m_cache->on == on) {
+        if (m_impl->m_cache->fingerprint == m_impl->fingerprint(on, nodes)) {
+            for (auto& [node, pos] : m_impl->m_cache->positions) {
+                node->setPosition(pos);
+            }
+            return;
+        }
+    }
+    m_impl->m_cache.reset();
+
     std::pair<int, int> minMaxPrio;
     bool doAutoScale = false;
 
@@ -752,7 +843,7 @@ void AxisLayout::apply(CCNode* on) {
     AxisLayoutOptions const* prev = nullptr;
 
     size_t ix = 0;
-    for (auto node : CCArrayExt<CCNode*>(nodes)) {
+    for (auto node : nodes) {
         // Require all nodes not to have this stupid option enabled because it 
         // screws up all position calculations
         node->ignoreAnchorPointForPosition(false);
@@ -809,6 +900,14 @@ void AxisLayout::apply(CCNode* on) {
         m_impl->maxScaleForPrio(nodes, minMaxPrio.second), 1.f, minMaxPrio.second,
         0
     );
+
+    auto& cache = m_impl->m_cache.emplace();
+    cache.on = on;
+    cache.fingerprint = m_impl->fingerprint(on, nodes);
+    cache.positions.reserve(nodes.size());
+    for (auto node : nodes) {
+        cache.positions.emplace_back(node, node->getPosition());
+    }
 }
 
 CCSize AxisLayout::getSizeHint(CCNode* on) const {
@@ -2,6 +2,10 @@
 #include <Geode/modify/CCFileUtils.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <cocos2d.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace geode::prelude;
 
@@ -9,6 +13,163 @@ static std::vector<CCTexturePack> REMOVED_PACKS;
 static std::vector<CCTexturePack> PACKS;
 static std::vector<std::string> PATHS;
 
+// Index of every file reachable through the search paths, so that resolving a
+// filename doesn't have to probe the filesystem once per search path.
+// Each root is listed once and kept around, so adding or removing a pack only
+// lists the roots that are new or whose directories have changed since they
+// were listed; the merged map is then rebuilt in memory. Files added to a root
+// are picked up on the next updatePaths, which is what the loader calls after
+// adding mod resources
+class ResourceIndex final {
+    struct Root {
+        std::string path;
+        std::unordered_set<std::string> files;
+        // Every listed directory and its last write time, which changes when
+        // an entry is added, removed or renamed in it
+        std::vector<std::pair<std::filesystem::path, std::filesystem::file_time_type>> directories;
+        bool exists = false;
+
+        bool isStale() const {
+            std::error_code ec;
+            if (!exists) {
+                return std::filesystem::is_directory(path, ec);
+            }
+            for (auto& [dir, time] : directories) {
+                auto current = std::filesystem::last_write_time(dir, ec);
+                if (ec || current != time) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<Root>> m_roots;
+    // relative filename -> root it should be resolved from, highest priority first wins
+    std::unordered_map<std::string, std::string> m_lookup;
+    // Bumped whenever the cocos search paths change; mods can add search paths
+    // without going through updatePaths, in which case the index is skipped
+    // until it's rebuilt from the current generation
+    std::atomic_size_t m_generation = 0;
+    std::atomic_size_t m_builtGeneration = 0;
+    std::atomic_bool m_ready = false;
+
+    static std::shared_ptr<Root> listRoot(std::string const& path) {
+        auto root = std::make_shared<Root>();
+        root->path = path;
+        if (!root->path.empty() && root->path.back() != '/' && root->path.back() != '\\') {
+            root->path.push_back('/');
+        }
+
+        std::error_code ec;
+        auto const dir = std::filesystem::path(path);
+        if (!std::filesystem::is_directory(dir, ec)) {
+            return root;
+        }
+        root->exists = true;
+        auto const addDirectory = [&](std::filesystem::path const& path) {
+            std::error_code ec;
+            auto time = std::filesystem::last_write_time(path, ec);
+            if (!ec) {
+                root->directories.emplace_back(path, time);
+            }
+        };
+        addDirectory(dir);
+        auto it = std::filesystem::recursive_directory_iterator(
+            dir, std::filesystem::directory_options::skip_permission_denied, ec
+        );
+        if (ec) {
+            return root;
+        }
+        for (auto end = std::filesystem::recursive_directory_iterator(); it != end; it.increment(ec)) {
+            if (ec) {
+                return root;
+            }
+            if (it->is_regular_file(ec)) {
+                root->files.insert(it->path().lexically_relative(dir).generic_string());
+            }
+            else if (it->is_directory(ec)) {
+                addDirectory(it->path());
+            }
+        }
+        return root;
+    }
+
+public:
+    static ResourceIndex& get() {
+        static ResourceIndex inst;
+        return inst;
+    }
+
+    size_t generation() const {
+        return m_generation;
+    }
+
+    /**
+     * Mark the index as out of date with the cocos search paths
+     */
+    void pathsChanged() {
+        ++m_generation;
+    }
+
+    void rebuild(size_t generation, std::vector<std::string> const& roots) {
+        std::unordered_map<std::string, std::shared_ptr<Root>> previous;
+        {
+            std::lock_guard lock(m_mutex);
+            previous = m_roots;
+        }
+
+        // list any roots we haven't seen yet outside of the lock
+        std::unordered_map<std::string, std::shared_ptr<Root>> next;
+        for (auto& path : roots) {
+            if (next.contains(path)) continue;
+            if (auto it = previous.find(path); it != previous.end() && !it->second->isStale()) {
+                next.insert({ path, it->second });
+            }
+            else {
+                next.insert({ path, listRoot(path) });
+            }
+        }
+
+        std::unordered_map<std::string, std::string> lookup;
+        for (auto& path : roots) {
+            auto& root = next.at(path);
+            for (auto& file : root->files) {
+                lookup.try_emplace(file, root->path);
+            }
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_roots = std::move(next);
+        m_lookup = std::move(lookup);
+        m_builtGeneration = generation;
+        m_ready = true;
+    }
+
+    void invalidate() {
+        std::lock_guard lock(m_mutex);
+        m_roots.clear();
+        m_lookup.clear();
+        m_ready = false;
+    }
+
+    /**
+     * Whether the index was built from the current search paths
+     */
+    bool isReady() const {
+        return m_ready && m_builtGeneration == m_generation;
+    }
+
+    std::optional<std::string> find(std::string const& filename) {
+        std::lock_guard lock(m_mutex);
+        if (auto it = m_lookup.find(filename); it != m_lookup.end()) {
+            return it->second + filename;
+        }
+        return std::nullopt;
+    }
+};
+
 #pragma warning(push)
 #pragma warning(disable : 4273)
 
@@ -99,6 +260,17 @@ void CCFileUtils::updatePaths() {
     for (auto& path : PATHS) {
         this->addSearchPath(path.c_str());
     }
+
+    // index every search path + resolution directory, in the order cocos would search them
+    auto& index = ResourceIndex::get();
+    auto const generation = index.generation();
+    std::vector<std::string> roots;
+    for (auto& path : m_searchPathArray) {
+        for (auto& resolution : m_searchResolutionsOrderArray) {
+            roots.push_back(std::string(path) + std::string(resolution));
+        }
+    }
+    index.rebuild(generation, roots);
 }
 
 #pragma warning(pop)
@@ -127,6 +299,69 @@ struct FileUtilsUpdatePaths : Modify<FileUtilsUpdatePaths, CCFileUtils> {
             return filename;
         }
 
+        auto& index = ResourceIndex::get();
+        if (this->isAbsolutePath(filename) || !index.isReady()) {
+            return CCFileUtils::fullPathForFilename(filename, unk);
+        }
+
+        if (auto it = m_fullPathCache.find(filename); it != m_fullPathCache.end()) {
+            return it->second;
+        }
+
+        // resolve through the index instead of asking the filesystem for every search path
+        std::string newFilename = this->getNewFilename(filename);
+        std::vector<std::string> candidates;
+        if (!unk) {
+            switch (CCDirector::get()->getLoadedTextureQuality()) {
+                case kTextureQualityHigh: candidates.push_back(this->addSuffix(newFilename, "-uhd")); break;
+                case kTextureQualityMedium: candidates.push_back(this->addSuffix(newFilename, "-hd")); break;
+                default: break;
+            }
+        }
+        candidates.push_back(newFilename);
+
+        for (auto& candidate : candidates) {
+            if (auto path = index.find(candidate)) {
+                m_fullPathCache[filename] = *path;
+                return *path;
+            }
+        }
+
+        // the file may be in a root that couldn't be listed (i.e. inside the
+        // apk on android) or may have been added after the root was listed,
+        // so let cocos look for it the slow way
         return CCFileUtils::fullPathForFilename(filename, unk);
     }
+
+    void setSearchPaths(gd::vector<gd::string> const& searchPaths) override {
+        CCFileUtils::setSearchPaths(searchPaths);
+        ResourceIndex::get().pathsChanged();
+    }
+
+    void addSearchPath(char const* path) override {
+        CCFileUtils::addSearchPath(path);
+        ResourceIndex::get().pathsChanged();
+    }
+
+    void removeSearchPath(char const* path) override {
+        CCFileUtils::removeSearchPath(path);
+        ResourceIndex::get().pathsChanged();
+    }
+
+    void setSearchResolutionsOrder(gd::vector<gd::string> const& searchResolutionsOrder) override {
+        CCFileUtils::setSearchResolutionsOrder(searchResolutionsOrder);
+        ResourceIndex::get().pathsChanged();
+    }
+
+    void addSearchResolutionsOrder(char const* order) override {
+        CCFileUtils::addSearchResolutionsOrder(order);
+        ResourceIndex::get().pathsChanged();
+    }
+
+    void purgeCachedEntries() override {
+        CCFileUtils::purgeCachedEntries();
+        // files on disk might have changed, so list everything again
+        ResourceIndex::get().invalidate();
+        this->updatePaths();
+    }
 };
@@ -1,8 +1,127 @@
 #include <Geode/core/Prelude.hpp>
 
 #include <cocos2d.h>
+#include <bit>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+#endif
+
 using namespace cocos2d;
 
+namespace {
+    // Below this many objects to remove, the plain nested loops are faster 
+    // than building a hash table
+    constexpr unsigned int HASHED_REMOVAL_THRESHOLD = 16;
+
+    // Returns the index of the first pointer equal to value, or count if 
+    // there is none. Compares 4 pointers at a time where SIMD is available
+    unsigned int findPointer(void* const* ptrs, unsigned int count, void* value) {
+        unsigned int i = 0;
+    #if defined(__x86_64__) || defined(_M_X64)
+        auto const needle = _mm_set1_epi64x(reinterpret_cast<long long>(value));
+        for (; i + 4 <= count; i += 4) {
+            auto a = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ptrs + i)), needle);
+            auto b = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ptrs + i + 2)), needle);
+            // SSE2 has no 64-bit compare, so a pointer only matches if both 
+            // of its 32-bit halves do
+            a = _mm_and_si128(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+            b = _mm_and_si128(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1)));
+            unsigned int mask = _mm_movemask_pd(_mm_castsi128_pd(a)) | (_mm_movemask_pd(_mm_castsi128_pd(b)) << 2);
+            if (mask) {
+                return i + std::countr_zero(mask);
+            }
+        }
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        auto const needle = vdupq_n_u64(reinterpret_cast<uint64_t>(value));
+        for (; i + 4 <= count; i += 4) {
+            auto a = vceqq_u64(vld1q_u64(reinterpret_cast<uint64_t const*>(ptrs + i)), needle);
+            auto b = vceqq_u64(vld1q_u64(reinterpret_cast<uint64_t const*>(ptrs + i + 2)), needle);
+            // the scalar loop below finds which of these 4 it was
+            if (vmaxvq_u32(vreinterpretq_u32_u64(vorrq_u64(a, b)))) {
+                break;
+            }
+        }
+    #endif
+        for (; i < count; i++) {
+            if (ptrs[i] == value) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    // A small open addressing hash table counting how many times each 
+    // pointer was added, used for removing many objects from an array in a 
+    // single pass
+    class PointerCounts final {
+        std::vector<std::pair<void*, unsigned int>> m_slots;
+        unsigned int m_shift;
+        // null marks empty slots, so null pointers are counted separately
+        unsigned int m_nullCount = 0;
+
+        size_t slotFor(void* ptr) const {
+            // fibonacci hashing, since pointers are aligned and their low 
+            // bits would otherwise all end up in the same few slots
+            return static_cast<size_t>(
+                (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) * 0x9E3779B97F4A7C15ull) >> m_shift
+            );
+        }
+
+    public:
+        PointerCounts(unsigned int count) {
+            // keep the load factor at most 50%
+            auto bits = std::bit_width(std::max(count, 1u) * 2u - 1u);
+            m_slots.resize(size_t(1) << bits);
+            m_shift = 64 - bits;
+        }
+
+        void add(void* ptr) {
+            if (!ptr) {
+                m_nullCount += 1;
+                return;
+            }
+            auto mask = m_slots.size() - 1;
+            for (auto i = this->slotFor(ptr);; i = (i + 1) & mask) {
+                auto& slot = m_slots[i];
+                if (slot.first == ptr || !slot.first) {
+                    slot.first = ptr;
+                    slot.second += 1;
+                    return;
+                }
+            }
+        }
+
+        unsigned int* find(void* ptr) {
+            if (!ptr) {
+                return m_nullCount ? &m_nullCount : nullptr;
+            }
+            auto mask = m_slots.size() - 1;
+            for (auto i = this->slotFor(ptr);; i = (i + 1) & mask) {
+                auto& slot = m_slots[i];
+                if (slot.first == ptr) {
+                    return &slot.second;
+                }
+                if (!slot.first) {
+                    return nullptr;
+                }
+            }
+        }
+    };
+
+    template <class T>
+    PointerCounts countPointers(T* const* ptrs, unsigned int count) {
+        PointerCounts counts(count);
+        for (unsigned int i = 0; i < count; i++) {
+            counts.add(ptrs[i]);
+        }
+        return counts;
+    }
+}
+
 CCObject* CCObject::copy()
 {
     return copyWithZone(0);
@@ -80,14 +199,8 @@ void cocos2d::ccArrayShrink(ccArray *arr)
 /** Returns index of first occurrence of object, CC_INVALID_INDEX if object not found. */
 unsigned int cocos2d::ccArrayGetIndexOfObject(ccArray *arr, CCObject* object)
 {
-    const unsigned int arrNum = arr->num;
-    CCObject** ptr = arr->arr;
-	for(unsigned int i = 0; i < arrNum; ++i, ++ptr)
-    {
-		if( *ptr == object ) return i;
-    }
-    
-	return CC_INVALID_INDEX;
+    auto index = findPointer(reinterpret_cast<void* const*>(arr->arr), arr->num, object);
+    return index == arr->num ? CC_INVALID_INDEX : index;
 }
 
 /** Returns a Boolean value that indicates whether object is present in array. */
@@ -222,9 +335,40 @@ void cocos2d::ccArrayRemoveObject(ccArray *arr, CCObject* object, bool bReleaseO
  first matching instance in arr will be removed. */
 void cocos2d::ccArrayRemoveArray(ccArray *arr, ccArray *minusArr)
 {
-	for(unsigned int i = 0; i < minusArr->num; i++)
+    if (minusArr->num < HASHED_REMOVAL_THRESHOLD)
+    {
+        for(unsigned int i = 0; i < minusArr->num; i++)
+        {
+            ccArrayRemoveObject(arr, minusArr->arr[i]);
+        }
+        return;
+    }
+
+    // Remove the first N matches of every object that's in minusArr N times 
+    // in one compaction pass, and only release the removed objects once arr 
+    // is consistent again in case that ends up deleting them
+    auto counts = countPointers(minusArr->arr, minusArr->num);
+    std::vector<CCObject*> removed;
+    unsigned int back = 0;
+    for (unsigned int i = 0; i < arr->num; i++)
     {
-		ccArrayRemoveObject(arr, minusArr->arr[i]);
+        auto count = counts.find(arr->arr[i]);
+        if (count && *count)
+        {
+            *count -= 1;
+            removed.push_back(arr->arr[i]);
+            back++;
+        }
+        else
+        {
+            arr->arr[i - back] = arr->arr[i];
+        }
+    }
+    arr->num -= back;
+
+    for (auto obj : removed)
+    {
+        obj->release();
     }
 }
 
@@ -232,6 +376,32 @@ void cocos2d::ccArrayRemoveArray(ccArray *arr, ccArray *minusArr)
  matching instances in arr will be removed. */
 void cocos2d::ccArrayFullRemoveArray(ccArray *arr, ccArray *minusArr)
 {
+    if (minusArr->num >= HASHED_REMOVAL_THRESHOLD)
+    {
+        auto counts = countPointers(minusArr->arr, minusArr->num);
+        std::vector<CCObject*> removed;
+        unsigned int back = 0;
+        for (unsigned int i = 0; i < arr->num; i++)
+        {
+            if (counts.find(arr->arr[i]))
+            {
+                removed.push_back(arr->arr[i]);
+                back++;
+            }
+            else
+            {
+                arr->arr[i - back] = arr->arr[i];
+            }
+        }
+        arr->num -= back;
+
+        for (auto obj : removed)
+        {
+            obj->release();
+        }
+        return;
+    }
+
 	unsigned int back = 0;
 	unsigned int i = 0;
 	
@@ -295,13 +465,8 @@ void cocos2d::ccCArrayEnsureExtraCapacity(ccCArray *arr, unsigned int extra)
 /** Returns index of first occurrence of value, CC_INVALID_INDEX if value not found. */
 unsigned int cocos2d::ccCArrayGetIndexOfValue(ccCArray *arr, void* value)
 {
-	unsigned int i;
-	
-	for( i = 0; i < arr->num; i++)
-    {
-		if( arr->arr[i] == value ) return i;
-    }
-	return CC_INVALID_INDEX;
+    auto index = findPointer(arr->arr, arr->num, value);
+    return index == arr->num ? CC_INVALID_INDEX : index;
 }
 
 /** Returns a Boolean value that indicates whether value is present in the C array. */
@@ -419,10 +584,31 @@ void cocos2d::ccCArrayRemoveValue(ccCArray *arr, void* value)
  */
 void cocos2d::ccCArrayRemoveArray(ccCArray *arr, ccCArray *minusArr)
 {
-	for(unsigned int i = 0; i < minusArr->num; i++)
+    if (minusArr->num < HASHED_REMOVAL_THRESHOLD)
     {
-		ccCArrayRemoveValue(arr, minusArr->arr[i]);
+        for(unsigned int i = 0; i < minusArr->num; i++)
+        {
+            ccCArrayRemoveValue(arr, minusArr->arr[i]);
+        }
+        return;
+    }
+
+    auto counts = countPointers(minusArr->arr, minusArr->num);
+    unsigned int back = 0;
+    for (unsigned int i = 0; i < arr->num; i++)
+    {
+        auto count = counts.find(arr->arr[i]);
+        if (count && *count)
+        {
+            *count -= 1;
+            back++;
+        }
+        else
+        {
+            arr->arr[i - back] = arr->arr[i];
+        }
     }
+    arr->num -= back;
 }
 
 /** Removes from arr all values in minusArr. For each value in minusArr, all matching instances in arr will be removed.
@@ -430,6 +616,25 @@ void cocos2d::ccCArrayRemoveArray(ccCArray *arr, ccCArray *minusArr)
  */
 void cocos2d::ccCArrayFullRemoveArray(ccCArray *arr, ccCArray *minusArr)
 {
+    if (minusArr->num >= HASHED_REMOVAL_THRESHOLD)
+    {
+        auto counts = countPointers(minusArr->arr, minusArr->num);
+        unsigned int back = 0;
+        for (unsigned int i = 0; i < arr->num; i++)
+        {
+            if (counts.find(arr->arr[i]))
+            {
+                back++;
+            }
+            else
+            {
+                arr->arr[i - back] = arr->arr[i];
+            }
+        }
+        arr->num -= back;
+        return;
+    }
+
 	unsigned int back = 0;
 	
 	for(unsigned int i = 0; i < arr->num; i++) 
@@ -42,6 +42,9 @@ private:
     std::string m_id = "";
     Ref<Layout> m_layout = nullptr;
     Ref<LayoutOptions> m_layoutOptions = nullptr;
+    LayoutUpdateMode m_layoutUpdateMode = LayoutUpdateMode::Immediate;
+    bool m_layoutDirty = false;
+    bool m_layoutSortChildren = false;
     std::unordered_map<std::string, Ref<CCObject>> m_userObjects;
     std::unordered_set<std::unique_ptr<EventListenerProtocol>> m_eventListeners;
     std::unordered_map<std::string, std::unique_ptr<EventListenerProtocol>> m_idEventListeners;
@@ -352,15 +355,78 @@ LayoutOptions* CCNode::getLayoutOptions() {
     return GeodeNodeMetadata::set(this)->m_layoutOptions.data();
 }
 
+// Nodes waiting for a deferred layout update
+static std::vector<Ref<CCNode>> s_dirtyLayouts;
+
 void CCNode::updateLayout(bool updateChildOrder) {
+    auto meta = GeodeNodeMetadata::set(this);
+    if (meta->m_layoutUpdateMode == LayoutUpdateMode::Deferred) {
+        meta->m_layoutSortChildren |= updateChildOrder;
+        if (!meta->m_layoutDirty) {
+            meta->m_layoutDirty = true;
+            s_dirtyLayouts.push_back(this);
+        }
+        return;
+    }
     if (updateChildOrder) {
         this->sortAllChildren();
     }
-    if (auto layout = GeodeNodeMetadata::set(this)->m_layout.data()) {
+    if (auto layout = meta->m_layout.data()) {
         layout->apply(this);
     }
 }
 
+void CCNode::setLayoutUpdateMode(LayoutUpdateMode mode) {
+    GeodeNodeMetadata::set(this)->m_layoutUpdateMode = mode;
+}
+
+LayoutUpdateMode CCNode::getLayoutUpdateMode() {
+    return GeodeNodeMetadata::set(this)->m_layoutUpdateMode;
+}
+
+void geode::applyDeferredLayouts() {
+    // Applying layouts may mark more nodes as dirty (like a child's layout 
+    // options changing), so keep going until nothing is left, but give up 
+    // eventually if layouts keep dirtying each other
+    for (size_t passes = 0; !s_dirtyLayouts.empty(); passes++) {
+        if (passes == 16) {
+            log::warn("Deferred layouts are still dirty after {} passes, giving up", passes);
+            for (auto& node : s_dirtyLayouts) {
+                GeodeNodeMetadata::set(node)->m_layoutDirty = false;
+            }
+            s_dirtyLayouts.clear();
+            return;
+        }
+
+        // Lay out the deepest nodes first, so when a parent is laid out its 
+        // children already have their final sizes
+        std::vector<std::pair<size_t, Ref<CCNode>>> nodes;
+        nodes.reserve(s_dirtyLayouts.size());
+        for (auto& node : s_dirtyLayouts) {
+            size_t depth = 0;
+            for (auto parent = node->getParent(); parent; parent = parent->getParent()) {
+                depth += 1;
+            }
+            nodes.emplace_back(depth, std::move(node));
+        }
+        s_dirtyLayouts.clear();
+        std::stable_sort(nodes.begin(), nodes.end(), [](auto const& a, auto const& b) {
+            return a.first > b.first;
+        });
+
+        for (auto& [_, node] : nodes) {
+            auto meta = GeodeNodeMetadata::set(node);
+            meta->m_layoutDirty = false;
+            if (std::exchange(meta->m_layoutSortChildren, false)) {
+                node->sortAllChildren();
+            }
+            if (auto layout = meta->m_layout.data()) {
+                layout->apply(node);
+            }
+        }
+    }
+}
+
 UserObjectSetEvent::UserObjectSetEvent(CCNode* node, std::string const& id, CCObject* value)
   : node(node), id(id), value(value) {}
 
@@ -6,10 +6,171 @@
 #include <loader/LoaderImpl.hpp>
 #include <loader/console.hpp>
 #include <loader/updater.hpp>
+#include <internal/tracing.hpp>
 #include <Geode/utils/NodeIDs.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 using namespace geode::prelude;
 
+namespace {
+    // Loads mod spritesheets with the PNGs decoded on worker threads, while
+    // the textures are created and the frames registered on the main thread
+    class SpritesheetLoader final {
+    private:
+        struct Sheet {
+            std::string png;
+            std::string plist;
+            CCImage* image = nullptr;
+            bool decoded = false;
+        };
+
+        std::vector<Sheet> m_sheets;
+        std::vector<std::thread> m_workers;
+        std::atomic_size_t m_nextToDecode = 0;
+        std::mutex m_mutex;
+        // Sheets are uploaded in order, so the mod that wins when several
+        // register the same frame name doesn't depend on decoding speed;
+        // this is also the index of the next sheet to upload
+        size_t m_uploaded = 0;
+
+        void decode() {
+            thread::setName("Spritesheet Loader");
+            for (size_t i = m_nextToDecode++; i < m_sheets.size(); i = m_nextToDecode++) {
+                auto& sheet = m_sheets[i];
+                tracing::Span span("Decode spritesheet", "resources", sheet.png);
+                auto image = new CCImage();
+                if (!image->initWithImageFileThreadSafe(sheet.png.c_str())) {
+                    image->release();
+                    image = nullptr;
+                }
+                std::lock_guard lock(m_mutex);
+                sheet.image = image;
+                sheet.decoded = true;
+            }
+        }
+
+        void upload(Sheet& sheet) {
+            if (!sheet.image) {
+                log::warn("Unable to load spritesheet {}", sheet.png);
+                return;
+            }
+            tracing::Span span("Upload spritesheet", "resources", sheet.png);
+            auto texture = CCTextureCache::get()->addUIImage(sheet.image, sheet.png.c_str());
+        #if CC_ENABLE_CACHE_TEXTURE_DATA
+            // addUIImage keeps the whole decoded image around to restore the
+            // texture when the GL context is lost, but it can just be reloaded
+            // from its file like the ones created by addImage
+            if (texture) {
+                VolatileTexture::removeTexture(texture);
+                VolatileTexture::addImageTexture(texture, sheet.png.c_str(), CCImage::kFmtPng);
+            }
+        #endif
+            sheet.image->release();
+            sheet.image = nullptr;
+            if (texture) {
+                CCSpriteFrameCache::get()->addSpriteFramesWithFile(sheet.plist.c_str(), texture);
+            }
+        }
+
+    public:
+        // Must be called on the main thread, as this resolves the sheets' paths
+        SpritesheetLoader(std::vector<Mod*> const& mods) {
+            auto ccfu = CCFileUtils::get();
+            for (auto mod : mods) {
+                for (auto const& sheet : mod->getMetadata().getSpritesheets()) {
+                    auto png = sheet + ".png";
+                    auto plist = sheet + ".plist";
+                    auto pngPath = std::string(ccfu->fullPathForFilename(png.c_str(), false));
+                    auto plistPath = std::string(ccfu->fullPathForFilename(plist.c_str(), false));
+                    if (png == pngPath || plist == plistPath) {
+                        log::warn(
+                            R"(The resource dir of "{}" is missing "{}" png and/or plist files)",
+                            mod->getID(), sheet
+                        );
+                        continue;
+                    }
+                    m_sheets.push_back({ std::move(pngPath), std::move(plistPath) });
+                }
+            }
+
+            auto threadCount = std::min<size_t>(
+                m_sheets.size(), std::max(std::thread::hardware_concurrency(), 1u)
+            );
+            for (size_t i = 0; i < threadCount; i++) {
+                m_workers.emplace_back(&SpritesheetLoader::decode, this);
+            }
+        }
+
+        SpritesheetLoader(SpritesheetLoader const&) = delete;
+        SpritesheetLoader& operator=(SpritesheetLoader const&) = delete;
+
+        ~SpritesheetLoader() {
+            // stop handing out new sheets to decode
+            m_nextToDecode = m_sheets.size();
+            for (auto& worker : m_workers) {
+                worker.join();
+            }
+            for (auto& sheet : m_sheets) {
+                if (sheet.image) {
+                    sheet.image->release();
+                }
+            }
+        }
+
+        size_t getTotalCount() const {
+            return m_sheets.size();
+        }
+        size_t getLoadedCount() const {
+            return m_uploaded;
+        }
+        bool isDone() const {
+            return m_uploaded == m_sheets.size();
+        }
+
+        /**
+         * Upload decoded sheets until the time budget runs out, so loading
+         * many sheets is spread over multiple frames
+         * @returns Whether every sheet has been loaded
+         */
+        bool uploadDecoded(std::chrono::steady_clock::duration budget) {
+            auto const deadline = std::chrono::steady_clock::now() + budget;
+            while (!this->isDone()) {
+                {
+                    // wait for the next sheet in order to be decoded, even if
+                    // later ones already are
+                    std::lock_guard lock(m_mutex);
+                    if (!m_sheets[m_uploaded].decoded) {
+                        break;
+                    }
+                }
+                this->upload(m_sheets[m_uploaded]);
+                m_uploaded += 1;
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+            }
+            return this->isDone();
+        }
+
+        /**
+         * Wait for every sheet to be decoded and upload all of them
+         */
+        void uploadAll() {
+            for (auto& worker : m_workers) {
+                worker.join();
+            }
+            m_workers.clear();
+            while (!this->isDone()) {
+                this->upload(m_sheets[m_uploaded]);
+                m_uploaded += 1;
+            }
+        }
+    };
+}
+
 struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     struct Fields {
         bool m_menuDisabled = false;
@@ -17,6 +178,8 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         CCLabelBMFont* m_smallLabel2 = nullptr;
         int m_geodeLoadStep = 0;
         int m_totalMods = 0;
+        int m_totalSheets = 0;
+        std::unique_ptr<SpritesheetLoader> m_sheetLoader;
     };
 
     static void onModify(auto& self) {
@@ -59,6 +222,12 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         NodeIDs::provideFor(this);
 
         m_fields->m_totalMods = Loader::get()->getAllMods().size();
+        // an estimate until the spritesheet loader knows which sheets exist
+        for (auto mod : Loader::get()->getAllMods()) {
+            if (mod->shouldLoad()) {
+                m_fields->m_totalSheets += mod->getMetadata().getSpritesheets().size();
+            }
+        }
         m_fields->m_menuDisabled = Loader::get()->getLaunchFlag("disable-custom-menu");
         if (m_fields->m_menuDisabled) {
             return true;
@@ -146,7 +315,34 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         log::debug("Loading mod resources");
         this->setSmallText("Loading mod resources");
         LoaderImpl::get()->updateResources(true);
-        this->continueLoadAssets();
+        m_fields->m_sheetLoader = std::make_unique<SpritesheetLoader>(this->getModsToLoadResourcesFor());
+        m_fields->m_totalSheets = m_fields->m_sheetLoader->getTotalCount();
+        this->loadModSpritesheets();
+    }
+
+    std::vector<Mod*> getModsToLoadResourcesFor() {
+        auto mods = Loader::get()->getAllMods();
+        std::erase_if(mods, [](Mod* mod) { return !mod->isEnabled(); });
+        return mods;
+    }
+
+    void loadModSpritesheets() {
+        auto loader = m_fields->m_sheetLoader.get();
+        // keep the game responsive while the sheets are being loaded
+        bool done = loader->uploadDecoded(std::chrono::milliseconds(8));
+        this->setSmallText(fmt::format(
+            "Loading mod resources: {}/{}", loader->getLoadedCount(), loader->getTotalCount()
+        ));
+        if (done) {
+            m_fields->m_sheetLoader = nullptr;
+            this->continueLoadAssets();
+        }
+        else {
+            this->updateLoadingBar();
+            Loader::get()->queueInMainThread([this]() {
+                this->loadModSpritesheets();
+            });
+        }
     }
 
     int getLoadedMods() {
@@ -163,12 +359,23 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         });
     }
     
+    int getLoadedSheets() {
+        // once the sheets are done loading, the step counter has moved on
+        if (m_fields->m_geodeLoadStep > 2) {
+            return m_fields->m_totalSheets;
+        }
+        if (auto loader = m_fields->m_sheetLoader.get()) {
+            return loader->getLoadedCount();
+        }
+        return 0;
+    }
+
     int getCurrentStep() {
-        return m_fields->m_geodeLoadStep + m_loadStep + getLoadedMods();
+        return m_fields->m_geodeLoadStep + m_loadStep + getLoadedMods() + getLoadedSheets();
     }
 
     int getTotalStep() {
-        return 3 + 14 + getEnabledMods();
+        return 3 + 14 + getEnabledMods() + m_fields->m_totalSheets;
     }
 
     void updateLoadingBar() {
@@ -211,7 +418,10 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         case 3:
         default:
             this->setSmallText("Loading game resources");
-            LoadingLayer::loadAssets();
+            {
+                tracing::Span span("Load game resources", "resources", fmt::format("step {}", m_loadStep));
+                LoadingLayer::loadAssets();
+            }
             break;
         }
         this->updateLoadingBar();
@@ -254,6 +464,9 @@ struct FallbackCustomLoadingLayer : Modify<FallbackCustomLoadingLayer, CCLayer>
         // TODO: verify loader resources on fallback?
 
         LoaderImpl::get()->updateResources(true);
+        auto mods = Loader::get()->getAllMods();
+        std::erase_if(mods, [](Mod* mod) { return !mod->isEnabled(); });
+        SpritesheetLoader(mods).uploadAll();
 
         return true;
     }
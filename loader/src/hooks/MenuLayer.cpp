@@ -13,6 +13,7 @@
 #include <loader/ModImpl.hpp>
 #include <loader/LoaderImpl.hpp>
 #include <loader/updater.hpp>
+#include <internal/tracing.hpp>
 #include <Geode/binding/ButtonSprite.hpp>
 #include <Geode/modify/LevelSelectLayer.hpp>
 
@@ -40,6 +41,9 @@ struct CustomMenuLayer : Modify<CustomMenuLayer, MenuLayer> {
     bool init() {
         if (!MenuLayer::init()) return false;
 
+        // reaching the main menu is the end of startup
+        tracing::finish();
+
         // make sure to add the string IDs for nodes (Geode has no manual
         // hook order support yet so gotta do this to ensure)
         NodeIDs::provideFor(this);
@@ -1,4 +1,5 @@
 #include <Geode/loader/Loader.hpp>
+#include <loader/LoaderImpl.hpp>
 
 using namespace geode::prelude;
 
@@ -6,13 +7,20 @@ using namespace geode::prelude;
 #include <Geode/modify/CCApplication.hpp>
 
 namespace {
-    void saveModData() {
+    void saveModData(bool sync) {
         log::info("Saving mod data...");
         log::NestScope nest;
 
         auto begin = std::chrono::high_resolution_clock::now();
 
-        (void)Loader::get()->saveData();
+        // only block the game when it's about to close, otherwise the files
+        // are written in the background
+        if (sync) {
+            LoaderImpl::get()->saveData();
+        }
+        else {
+            LoaderImpl::get()->saveDataAsync();
+        }
 
         auto end = std::chrono::high_resolution_clock::now();
         auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
@@ -23,7 +31,8 @@ namespace {
 struct SaveLoader : Modify<SaveLoader, AppDelegate> {
     GEODE_FORWARD_COMPAT_DISABLE_HOOKS("save moved to CCApplication::gameDidSave()")
     void trySaveGame(bool p0) {
-        saveModData();
+        // game::exit and game::restart call trySaveGame(true) right before quitting
+        saveModData(p0);
         return AppDelegate::trySaveGame(p0);
     }
 };
@@ -33,7 +42,7 @@ struct SaveLoader : Modify<SaveLoader, AppDelegate> {
 struct FallbackSaveLoader : Modify<FallbackSaveLoader, CCApplication> {
     GEODE_FORWARD_COMPAT_ENABLE_HOOKS("")
     void gameDidSave() {
-        saveModData();
+        saveModData(false);
         return CCApplication::gameDidSave();
     }
 };
@@ -1,4 +1,5 @@
 #include <loader/LoaderImpl.hpp>
+#include <Geode/ui/Layout.hpp>
 
 using namespace geode::prelude;
 
@@ -7,6 +8,9 @@ using namespace geode::prelude;
 struct FunctionQueue : Modify<FunctionQueue, CCScheduler> {
     void update(float dt) {
         LoaderImpl::get()->executeMainThreadQueue();
-        return CCScheduler::update(dt);
+        CCScheduler::update(dt);
+        // The scheduler is updated right before the scene is drawn, so this 
+        // is the last chance to lay out nodes that deferred their layout
+        applyDeferredLayouts();
     }
 };
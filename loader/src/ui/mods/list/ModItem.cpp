@@ -20,9 +20,12 @@ bool ModItem::init(ModSource&& source) {
     if (!CCNode::init())
         return false;
     
-    m_source = std::move(source);
     this->setID("ModItem");
 
+    // Everything that doesn't depend on the mod is only created once here, as 
+    // mod lists reuse items for different mods when scrolling; `bind` then 
+    // fills it in for the current mod
+
     m_bg = CCScale9Sprite::create("square02b_small.png");
     m_bg->setID("bg");
     m_bg->setOpacity(0);
@@ -31,10 +34,6 @@ bool ModItem::init(ModSource&& source) {
     m_bg->setScale(.7f);
     this->addChildAtPosition(m_bg, Anchor::Center);
 
-    m_logo = this->createModLogo();
-    m_logo->setID("logo-sprite");
-    this->addChild(m_logo);
-
     m_infoContainer = CCNode::create();
     m_infoContainer->setID("info-container");
     m_infoContainer->setScale(.4f);
@@ -44,7 +43,7 @@ bool ModItem::init(ModSource&& source) {
     m_titleContainer->setID("title-container");
     m_titleContainer->setAnchorPoint({ .0f, .5f });
 
-    m_titleLabel = CCLabelBMFont::create(m_source.getMetadata().getName().c_str(), "bigFont.fnt");
+    m_titleLabel = CCLabelBMFont::create("", "bigFont.fnt");
     m_titleLabel->setID("title-label");
     m_titleLabel->setLayoutOptions(AxisLayoutOptions::create()->setScaleLimits(.3f, std::nullopt));
     m_titleContainer->addChild(m_titleLabel);
@@ -71,14 +70,13 @@ bool ModItem::init(ModSource&& source) {
     m_developers->ignoreAnchorPointForPosition(false);
     m_developers->setAnchorPoint({ .0f, .5f });
 
-    auto by = m_source.formatDevelopers();
-    m_developerLabel = CCLabelBMFont::create(by.c_str(), "goldFont.fnt");
+    m_developerLabel = CCLabelBMFont::create("", "goldFont.fnt");
     m_developerLabel->setID("developers-label");
-    auto developersBtn = CCMenuItemSpriteExtra::create(
+    m_developersBtn = CCMenuItemSpriteExtra::create(
         m_developerLabel, this, menu_selector(ModItem::onDevelopers)
     );
-    developersBtn->setID("developers-button");
-    m_developers->addChild(developersBtn);
+    m_developersBtn->setID("developers-button");
+    m_developers->addChild(m_developersBtn);
 
     m_developers->setLayout(
         RowLayout::create()
@@ -92,14 +90,8 @@ bool ModItem::init(ModSource&& source) {
     m_description->setColor(ccBLACK);
     m_description->setOpacity(90);
 
-    auto desc = m_source.getMetadata().getDescription();
-    auto descLabel = CCLabelBMFont::create(
-        desc.value_or("[No Description Provided]").c_str(),
-        "chatFont.fnt"
-    );
-    descLabel->setColor(desc ? ccWHITE : ccGRAY);
-    limitNodeWidth(descLabel, m_description->getContentWidth() - 20, 2.f, .1f);
-    m_description->addChildAtPosition(descLabel, Anchor::Left, ccp(10, 0), ccp(0, .5f));
+    m_descriptionLabel = CCLabelBMFont::create("", "chatFont.fnt");
+    m_description->addChildAtPosition(m_descriptionLabel, Anchor::Left, ccp(10, 0), ccp(0, .5f));
 
     m_infoContainer->addChildAtPosition(m_description, Anchor::Left);
 
@@ -157,36 +149,80 @@ bool ModItem::init(ModSource&& source) {
 
     m_infoContainer->addChildAtPosition(m_downloadWaiting, Anchor::Left);
 
+    // Shown for server mods that other installed mods recommend
+    m_recommendedBy = CCNode::create();
+    m_recommendedBy->setID("recommended-container");
+    m_recommendedBy->setContentWidth(225);
+    auto byLabel = CCLabelBMFont::create("Recommended by ", "bigFont.fnt");
+    byLabel->setID("recommended-label");
+    byLabel->setColor("mod-list-recommended-by"_cc3b);
+    m_recommendedBy->addChild(byLabel);
+
+    m_recommendedByNameLabel = CCLabelBMFont::create("", "bigFont.fnt");
+    m_recommendedByNameLabel->setID("recommended-name-label");
+    m_recommendedByNameLabel->setColor("mod-list-recommended-by-2"_cc3b);
+    m_recommendedBy->addChild(m_recommendedByNameLabel);
+
+    m_recommendedBy->setLayout(
+        RowLayout::create()
+            ->setDefaultScaleLimits(.1f, 1.f)
+            ->setAxisAlignment(AxisAlignment::Start)
+    );
+    m_infoContainer->addChildAtPosition(m_recommendedBy, Anchor::Left);
+
     this->addChildAtPosition(m_infoContainer, Anchor::Left);
 
     m_viewMenu = CCMenu::create();
     m_viewMenu->setID("view-menu");
     m_viewMenu->setScale(.55f);
 
-    ButtonSprite* spr = nullptr;
-    if (auto serverMod = m_source.asServer(); serverMod != nullptr) {
-        auto version = serverMod->latestVersion();
+    m_viewSpr = createGeodeButton("View", 50, false, true);
+    m_viewBtn = CCMenuItemSpriteExtra::create(m_viewSpr, this, menu_selector(ModItem::onView));
+    m_viewBtn->setID("view-button");
+    m_viewMenu->addChild(m_viewBtn);
 
-        auto geodeValid = Loader::get()->isModVersionSupported(version.getGeodeVersion());
-        auto gameVersion = version.getGameVersion();
-        auto gdValid = !gameVersion || gameVersion == "*" || gameVersion == GEODE_STR(GEODE_GAME_VERSION);
+    // Add an enable button for installed mods that are enablable
+    m_enableToggle = CCMenuItemToggler::createWithStandardSprites(
+        this, menu_selector(ModItem::onEnable), 1.f
+    );
+    m_enableToggle->setID("enable-toggler");
+    // Manually handle toggle state
+    m_enableToggle->m_notClickable = true;
+    m_viewMenu->addChild(m_enableToggle);
+
+    auto viewErrorSpr = createGeodeCircleButton(
+        CCSprite::createWithSpriteFrameName("exclamation.png"_spr), 1.f,
+        CircleBaseSize::Small
+    );
+    m_viewErrorBtn = CCMenuItemSpriteExtra::create(
+        viewErrorSpr, this, menu_selector(ModItem::onViewError)
+    );
+    m_viewErrorBtn->setID("view-error-button");
+    m_viewMenu->addChild(m_viewErrorBtn);
 
-        if (!geodeValid || !gdValid) {
-            spr = createGeodeButton("N/A", 50, false, true, GeodeButtonSprite::Gray);
-        }
-    }
+    // Show mod download count here already so people can make informed decisions 
+    // on which mods to install
+    m_downloadCountContainer = CCNode::create();
 
-    if (!spr) {
-        if (Loader::get()->isModInstalled(m_source.getID())) {
-            spr = createGeodeButton("View", 50, false, true);
-        } else {
-            spr = createGeodeButton("Get", 50, false, true, GeodeButtonSprite::Install);
-        }
-    }
+    m_downloadsLabel = CCLabelBMFont::create("", "bigFont.fnt");
+    m_downloadsLabel->setID("downloads-label");
+    m_downloadsLabel->setColor("mod-list-version-label"_cc3b);
+    m_downloadCountContainer->addChildAtPosition(m_downloadsLabel, Anchor::Right, ccp(-0, 0), ccp(1, .5f));
 
-    auto viewBtn = CCMenuItemSpriteExtra::create(spr, this, menu_selector(ModItem::onView));
-    viewBtn->setID("view-button");
-    m_viewMenu->addChild(viewBtn);
+    m_downloadsIcon = CCSprite::createWithSpriteFrameName("GJ_downloadsIcon_001.png");
+    m_downloadsIcon->setID("downloads-icon-sprite");
+    m_downloadsIcon->setScale(1.2f);
+    m_downloadCountContainer->addChildAtPosition(m_downloadsIcon, Anchor::Left, ccp(8, 0));
+
+    auto updateSpr = createGeodeCircleButton(
+        CCSprite::createWithSpriteFrameName("update.png"_spr), 1.15f,
+        CircleBaseSize::Medium, true
+    );
+    m_updateBtn = CCMenuItemSpriteExtra::create(
+        updateSpr, this, menu_selector(ModItem::onInstall)
+    );
+    m_updateBtn->setID("update-button");
+    m_viewMenu->addChild(m_updateBtn);
 
     m_viewMenu->setLayout(
         RowLayout::create()
@@ -201,31 +237,79 @@ bool ModItem::init(ModSource&& source) {
     m_badgeContainer->setID("badge-container");
     m_badgeContainer->setLayoutOptions(AxisLayoutOptions::create()->setScaleLimits(.1f, .8f));
 
+    m_checkUpdateListener.bind(this, &ModItem::onCheckUpdates);
+    m_updateStateListener.bind([this](auto) { this->updateState(); });
+    m_downloadListener.bind([this](auto) { this->updateState(); });
+    m_settingNodeListener.bind([this](SettingNodeValueChangeEvent*) {
+        this->updateState();
+        return ListenerResult::Propagate;
+    });
+
+    this->bind(std::move(source));
+
+    return true;
+}
+
+void ModItem::bind(ModSource&& source) {
+    m_source = std::move(source);
+    m_availableUpdate = std::nullopt;
+
+    // The logo is loaded for the specific mod, so it's the only node replaced
+    if (m_logo) {
+        m_logo->removeFromParent();
+    }
+    m_logo = this->createModLogo();
+    m_logo->setID("logo-sprite");
+    this->addChild(m_logo);
+
+    m_titleLabel->setString(m_source.getMetadata().getName().c_str());
+
+    m_developerLabel->setString(m_source.formatDevelopers().c_str());
+    m_developersBtn->updateSprite();
+
+    auto desc = m_source.getMetadata().getDescription();
+    m_descriptionLabel->setString(desc.value_or("[No Description Provided]").c_str());
+    m_descriptionLabel->setColor(desc ? ccWHITE : ccGRAY);
+    limitNodeWidth(m_descriptionLabel, m_description->getContentWidth() - 20, 2.f, .1f);
+
+    const char* viewText = nullptr;
+    auto viewBG = GeodeButtonSprite::Default;
+    if (auto serverMod = m_source.asServer(); serverMod != nullptr) {
+        auto version = serverMod->latestVersion();
+
+        auto geodeValid = Loader::get()->isModVersionSupported(version.getGeodeVersion());
+        auto gameVersion = version.getGameVersion();
+        auto gdValid = !gameVersion || gameVersion == "*" || gameVersion == GEODE_STR(GEODE_GAME_VERSION);
+
+        if (!geodeValid || !gdValid) {
+            viewText = "N/A";
+            viewBG = GeodeButtonSprite::Gray;
+        }
+    }
+
+    if (!viewText) {
+        if (Loader::get()->isModInstalled(m_source.getID())) {
+            viewText = "View";
+        } else {
+            viewText = "Get";
+            viewBG = GeodeButtonSprite::Install;
+        }
+    }
+    m_viewSpr->setString(viewText);
+    m_viewSpr->updateBGImage(getGeodeButtonSpriteName(viewBG));
+    m_viewBtn->updateSprite();
+
+    m_enableToggle->setVisible(false);
+    m_viewErrorBtn->setVisible(false);
+    m_downloadCountContainer->setVisible(false);
+    m_recommendedBy->setVisible(false);
+    m_badgeContainer->removeAllChildren();
+
     // Handle source-specific stuff
     m_source.visit(makeVisitor {
         [this](Mod* mod) {
-            // Add an enable button if the mod is enablable
-            if (!mod->isInternal()) {
-                m_enableToggle = CCMenuItemToggler::createWithStandardSprites(
-                    this, menu_selector(ModItem::onEnable), 1.f
-                );
-                m_enableToggle->setID("enable-toggler");
-                // Manually handle toggle state
-                m_enableToggle->m_notClickable = true;
-                m_viewMenu->addChild(m_enableToggle);
-                m_viewMenu->updateLayout();
-            }
-            if (mod->hasLoadProblems() || mod->targetsOutdatedVersion()) {
-                auto viewErrorSpr = createGeodeCircleButton(
-                    CCSprite::createWithSpriteFrameName("exclamation.png"_spr), 1.f,
-                    CircleBaseSize::Small
-                );
-                auto viewErrorBtn = CCMenuItemSpriteExtra::create(
-                    viewErrorSpr, this, menu_selector(ModItem::onViewError)
-                );
-                viewErrorBtn->setID("view-error-button");
-                m_viewMenu->addChild(viewErrorBtn);
-            }
+            m_enableToggle->setVisible(!mod->isInternal());
+            m_viewErrorBtn->setVisible(mod->hasLoadProblems() || mod->targetsOutdatedVersion());
         },
         [this](server::ServerModMetadata const& metadata) {
             // todo: there has to be a better way to deal with the short/long alternatives
@@ -262,24 +346,13 @@ bool ModItem::init(ModSource&& source) {
                 m_badgeContainer->addChild(longVer);
             }
 
-            // Show mod download count here already so people can make informed decisions 
-            // on which mods to install
-            m_downloadCountContainer = CCNode::create();
-            
-            auto downloads = CCLabelBMFont::create(numToAbbreviatedString(metadata.downloadCount).c_str(), "bigFont.fnt");
-            downloads->setID("downloads-label");
-            downloads->setColor("mod-list-version-label"_cc3b);
-            downloads->limitLabelWidth(125, 1.f, .1f);
-            m_downloadCountContainer->addChildAtPosition(downloads, Anchor::Right, ccp(-0, 0), ccp(1, .5f));
-
-            auto downloadsIcon = CCSprite::createWithSpriteFrameName("GJ_downloadsIcon_001.png");
-            downloadsIcon->setID("downloads-icon-sprite");
-            downloadsIcon->setScale(1.2f);
-            m_downloadCountContainer->addChildAtPosition(downloadsIcon, Anchor::Left, ccp(8, 0));
+            m_downloadCountContainer->setVisible(true);
+            m_downloadsLabel->setString(numToAbbreviatedString(metadata.downloadCount).c_str());
+            m_downloadsLabel->limitLabelWidth(125, 1.f, .1f);
 
             // m_downloadCountContainer scale is controlled in updateState
             m_downloadCountContainer->setContentSize({
-                downloads->getScaledContentWidth() + downloadsIcon->getScaledContentWidth(),
+                m_downloadsLabel->getScaledContentWidth() + m_downloadsIcon->getScaledContentWidth(),
                 30
             });
             m_downloadCountContainer->updateLayout();
@@ -296,67 +369,31 @@ bool ModItem::init(ModSource&& source) {
                 }
 
                 if (recommends.size() > 0) {
-                    m_recommendedBy = CCNode::create();
-                    m_recommendedBy->setID("recommended-container");
-                    m_recommendedBy->setContentWidth(225);
-                    auto byLabel = CCLabelBMFont::create("Recommended by ", "bigFont.fnt");
-                    byLabel->setID("recommended-label");
-                    byLabel->setColor("mod-list-recommended-by"_cc3b);
-                    m_recommendedBy->addChild(byLabel);
-
                     std::string recommendStr = "";
                     if (recommends.size() == 1) {
                         recommendStr = recommends[0]->getName();
                     } else {
                         recommendStr = fmt::format("{} installed mods", recommends.size());
                     }
-
-                    auto nameLabel = CCLabelBMFont::create(recommendStr.c_str(), "bigFont.fnt");
-                    nameLabel->setID("recommended-name-label");
-                    nameLabel->setColor("mod-list-recommended-by-2"_cc3b);
-                    m_recommendedBy->addChild(nameLabel);
-
-                    m_recommendedBy->setLayout(
-                        RowLayout::create()
-                            ->setDefaultScaleLimits(.1f, 1.f)
-                            ->setAxisAlignment(AxisAlignment::Start)
-                    );
-                    m_infoContainer->addChildAtPosition(m_recommendedBy, Anchor::Left);
+                    m_recommendedByNameLabel->setString(recommendStr.c_str());
+                    m_recommendedBy->setVisible(true);
                 }
             }
         }
     });
 
-    auto updateSpr = createGeodeCircleButton(
-        CCSprite::createWithSpriteFrameName("update.png"_spr), 1.15f,
-        CircleBaseSize::Medium, true
-    );
-    m_updateBtn = CCMenuItemSpriteExtra::create(
-        updateSpr, this, menu_selector(ModItem::onInstall)
-    );
-    m_updateBtn->setID("update-button");
-    m_viewMenu->addChild(m_updateBtn);
-
     if (m_source.asMod()) {
-        m_checkUpdateListener.bind(this, &ModItem::onCheckUpdates);
         m_checkUpdateListener.setFilter(m_source.checkUpdates());
     }
+    else {
+        m_checkUpdateListener.setFilter(server::ServerRequest<std::optional<server::ServerModUpdate>>());
+    }
 
     this->updateState();
 
     // Only listen for updates on this mod specifically
-    m_updateStateListener.bind([this](auto) { this->updateState(); });
     m_updateStateListener.setFilter(UpdateModListStateFilter(UpdateModState(m_source.getID())));
-
-    m_downloadListener.bind([this](auto) { this->updateState(); });
     m_downloadListener.setFilter(server::ModDownloadFilter(m_source.getID()));
-
-    m_settingNodeListener.bind([this](SettingNodeValueChangeEvent*) {
-        this->updateState();
-        return ListenerResult::Propagate;
-    });
-
-    return true;
 }
 
 void ModItem::updateState() {
@@ -365,13 +402,11 @@ void ModItem::updateState() {
     bool isDownloading = download && download->isActive();
 
     // Update the size of the mod cell itself
+    this->setContentSize(ModItem::getCellSize(m_targetWidth, m_display));
     if (m_display == ModListDisplay::Grid) {
-        auto widthWithoutGaps = m_targetWidth - 7.5f;
-        this->setContentSize(ccp(widthWithoutGaps / roundf(widthWithoutGaps / 80), 100));
         m_bg->setContentSize(m_obContentSize / m_bg->getScale());
     }
     else {
-        this->setContentSize(ccp(m_targetWidth, m_display == ModListDisplay::BigList ? 40 : 30));
         m_bg->setContentSize((m_obContentSize - ccp(6, 0)) / m_bg->getScale());
     }
 
@@ -387,7 +422,7 @@ void ModItem::updateState() {
     }
 
     // Show download separator if there is something to separate and we're in grid view
-    m_versionDownloadSeparator->setVisible(m_downloadCountContainer && m_display == ModListDisplay::Grid);
+    m_versionDownloadSeparator->setVisible(m_downloadCountContainer->isVisible() && m_display == ModListDisplay::Grid);
 
     // Download counts go next to the version like on the website on grid view
     if (m_downloadCountContainer) {
@@ -697,23 +732,22 @@ void ModItem::updateState() {
     }
 
     // Update enable toggle state
-    if (m_enableToggle && m_source.asMod()) {
+    if (m_source.asMod()) {
         m_enableToggle->toggle(m_source.asMod()->isOrWillBeEnabled());
 
         // Disable the toggle if the mod has been uninstalled or if the mod is 
         // outdated
-        if (
+        // The toggle is reused for other mods, so it's reset otherwise
+        auto disabled = 
             modRequestedActionIsUninstall(m_source.asMod()->getRequestedAction()) || 
-            m_source.asMod()->targetsOutdatedVersion()
-        ) {
-            m_enableToggle->setEnabled(false);
-            auto off = typeinfo_cast<CCRGBAProtocol*>(m_enableToggle->m_offButton->getNormalImage());
-            auto on = typeinfo_cast<CCRGBAProtocol*>(m_enableToggle->m_onButton->getNormalImage());
-            off->setColor(ccGRAY);
-            off->setOpacity(105);
-            on->setColor(ccGRAY);
-            on->setOpacity(105);
-        }
+            m_source.asMod()->targetsOutdatedVersion();
+        m_enableToggle->setEnabled(!disabled);
+        auto off = typeinfo_cast<CCRGBAProtocol*>(m_enableToggle->m_offButton->getNormalImage());
+        auto on = typeinfo_cast<CCRGBAProtocol*>(m_enableToggle->m_onButton->getNormalImage());
+        off->setColor(disabled ? ccGRAY : ccWHITE);
+        off->setOpacity(disabled ? 105 : 255);
+        on->setColor(disabled ? ccGRAY : ccWHITE);
+        on->setOpacity(disabled ? 105 : 255);
     }
 
     this->updateLayout();
@@ -721,6 +755,22 @@ void ModItem::updateState() {
     ModItemUIEvent(std::make_unique<ModItemUIEvent::Impl>(this)).post();
 }
 
+size_t ModItem::getColumnCount(float width, ModListDisplay display) {
+    if (display == ModListDisplay::Grid) {
+        return static_cast<size_t>(std::max(roundf((width - 7.5f) / 80), 1.f));
+    }
+    return 1;
+}
+
+CCSize ModItem::getCellSize(float width, ModListDisplay display) {
+    if (display == ModListDisplay::Grid) {
+        // columns are 2.5 units apart, matching the gap ModList sets
+        auto cols = ModItem::getColumnCount(width, display);
+        return ccp((width - 2.5f * (cols - 1)) / cols, 100);
+    }
+    return ccp(width, display == ModListDisplay::BigList ? 40 : 30);
+}
+
 void ModItem::updateDisplay(float width, ModListDisplay display) {
     m_display = display;
     m_targetWidth = width;
@@ -55,21 +55,27 @@ class ModItem : public CCNode {
 protected:
     ModSource m_source;
     CCScale9Sprite* m_bg;
-    CCNode* m_logo;
+    CCNode* m_logo = nullptr;
     CCNode* m_infoContainer;
     CCNode* m_titleContainer;
     Ref<CCLabelBMFont> m_titleLabel;
     CCLabelBMFont* m_versionLabel;
     CCNode* m_developers;
-    CCNode* m_recommendedBy;
+    CCNode* m_recommendedBy = nullptr;
+    CCLabelBMFont* m_recommendedByNameLabel;
     CCScale9Sprite* m_description;
+    CCLabelBMFont* m_descriptionLabel;
     CCLabelBMFont* m_developerLabel;
+    CCMenuItemSpriteExtra* m_developersBtn;
     ButtonSprite* m_restartRequiredLabel;
     ButtonSprite* m_outdatedLabel;
     CCNode* m_downloadWaiting;
     CCNode* m_downloadBarContainer;
     Slider* m_downloadBar;
     CCMenu* m_viewMenu;
+    ButtonSprite* m_viewSpr;
+    CCMenuItemSpriteExtra* m_viewBtn;
+    CCMenuItemSpriteExtra* m_viewErrorBtn;
     CCMenuItemToggler* m_enableToggle = nullptr;
     CCMenuItemSpriteExtra* m_updateBtn = nullptr;
     EventListener<UpdateModListStateFilter> m_updateStateListener;
@@ -79,6 +85,8 @@ protected:
     EventListener<EventFilter<SettingNodeValueChangeEvent>> m_settingNodeListener;
     Ref<CCNode> m_badgeContainer = nullptr;
     Ref<CCNode> m_downloadCountContainer;
+    CCLabelBMFont* m_downloadsLabel;
+    CCSprite* m_downloadsIcon;
     ModListDisplay m_display = ModListDisplay::SmallList;
     float m_targetWidth = 300;
     CCLabelBMFont* m_versionDownloadSeparator;
@@ -102,7 +110,13 @@ protected:
 public:
     static ModItem* create(ModSource&& source);
 
+    /**
+     * Show a different mod in this item, keeping its current display
+     */
+    void bind(ModSource&& source);
     void updateDisplay(float width, ModListDisplay display);
+    static CCSize getCellSize(float width, ModListDisplay display);
+    static size_t getColumnCount(float width, ModListDisplay display);
 
     ModSource& getSource() &;
 
@@ -34,7 +34,19 @@ bool ModList::init(ModListSource* src, CCSize const& size) {
     m_source = src;
     m_source->reset();
     
-    m_list = ScrollLayer::create(size);
+    // Only the items in view get a ModItem, which are rebound to other mods 
+    // as the list is scrolled
+    m_list = RecyclingScrollLayer::create(
+        size,
+        [this](size_t index) -> CCNode* {
+            auto item = ModItem::create(ModSource(m_pageContents->getMods().at(index)));
+            item->updateDisplay(m_list->getContentWidth(), m_display);
+            return item;
+        },
+        [this](CCNode* cell, size_t index) {
+            static_cast<ModItem*>(cell)->bind(ModSource(m_pageContents->getMods().at(index)));
+        }
+    );
     this->addChildAtPosition(m_list, Anchor::Bottom, ccp(-m_list->getScaledContentWidth() / 2, 0));
 
     m_topContainer = CCNode::create();
@@ -404,27 +416,13 @@ void ModList::onPromise(ModListSource::PageLoadTask::Event* event) {
             // Hide status
             m_statusContainer->setVisible(false);
 
-            auto& list = std::static_pointer_cast<GeodeModListPage>(result->unwrap())->m_mods;
-
-            // Create items
-            bool first = true;
-            for (auto item : list) {
-                // Add separators between items after the first one
-                if (!first) {
-                    // auto separator = CCLayerColor::create(
-                    //     ColorProvider::get()->define("mod-list-separator"_spr, { 255, 255, 255, 45 })
-                    // );
-                    // separator->setContentSize({ m_obContentSize.width - 10, .5f });
-                    // m_list->m_contentLayer->addChild(separator);
-                }
-                first = false;
-                m_list->m_contentLayer->addChild(item);
-            }
+            // Items are created as they come into view
+            m_pageContents = std::static_pointer_cast<GeodeModListPage>(result->unwrap());
+            m_list->reloadData(m_pageContents->getMods().size());
             this->updateDisplay(m_display);
 
             // Scroll list to top
-            auto listTopScrollPos = -m_list->m_contentLayer->getContentHeight() + m_list->getContentHeight();
-            m_list->m_contentLayer->setPositionY(listTopScrollPos);
+            m_list->scrollToTop();
 
             // Update page UI
             this->updateState();
@@ -573,48 +571,20 @@ void ModList::updateDisplay(ModListDisplay display) {
     m_display = display;
     m_source->setPageSize(getDisplayPageSize(m_source, m_display));
 
-    // Update all BaseModItems that are children of the list
-    // There may be non-BaseModItems there (like separators) so gotta be type-safe
-    for (auto& node : CCArrayExt<CCNode*>(m_list->m_contentLayer->getChildren())) {
-        if (auto item = typeinfo_cast<ModItem*>(node)) {
-            item->updateDisplay(m_list->getContentWidth(), display);
-        }
-    }
-
     // Store old relative scroll position (ensuring no divide by zero happens)
     auto oldPositionArea = m_list->m_contentLayer->getContentHeight() - m_list->getContentHeight();
     auto oldPosition = oldPositionArea > 0.f ?
         m_list->m_contentLayer->getPositionY() / oldPositionArea : 
         -1.f;
 
-    // Update the list layout based on the display model
-    if (display == ModListDisplay::Grid) {
-        m_list->m_contentLayer->setLayout(
-            RowLayout::create()
-                ->setGrowCrossAxis(true)
-                ->setAxisAlignment(AxisAlignment::Start)
-                ->setGap(2.5f)
-        );
-    }
-    else {
-        m_list->m_contentLayer->setLayout(
-            ColumnLayout::create()
-                ->setAxisReverse(true)
-                ->setAxisAlignment(AxisAlignment::End)
-                ->setAutoGrowAxis(m_obContentSize.height)
-                ->setGap(2.5f)
-        );
-    }
-
-    // Make sure list isn't too small
-    // NOTE: Do NOT call `updateLayout` on m_list, it'll undo this!
-    if (m_list->m_contentLayer->getContentHeight() < m_list->getContentHeight()) {
-        auto diff = m_list->getContentHeight() - m_list->m_contentLayer->getContentHeight();
-        m_list->m_contentLayer->setContentHeight(m_list->getContentHeight());
-        for (auto child : CCArrayExt<CCNode*>(m_list->m_contentLayer->getChildren())) {
-            child->setPositionY(child->getPositionY() + diff);
-        }
-    }
+    // Update the cell layout based on the display model. If the size of the 
+    // items changes, the list recreates them for the new size
+    auto width = m_list->getContentWidth();
+    m_list->setCellSize(
+        ModItem::getCellSize(width, display),
+        ModItem::getColumnCount(width, display),
+        2.5f
+    );
 
     // Preserve relative scroll position
     m_list->m_contentLayer->setPositionY((
@@ -662,9 +632,14 @@ void ModList::reloadPage() {
     this->gotoPage(m_page, true);
 }
 
+void ModList::clearList() {
+    m_list->reloadData(0);
+    m_pageContents = nullptr;
+}
+
 void ModList::gotoPage(size_t page, bool update) {
     // Clear list contents
-    m_list->m_contentLayer->removeAllChildren();
+    this->clearList();
     m_page = page;
 
     // Update page size (if needed)
@@ -683,7 +658,7 @@ void ModList::gotoPage(size_t page, bool update) {
 
 void ModList::showStatus(ModListStatus status, std::string const& message, std::optional<std::string> const& details) {
     // Clear list contents
-    m_list->m_contentLayer->removeAllChildren();
+    this->clearList();
 
     // Update status
     m_statusTitle->setString(message.c_str());
@@ -763,6 +738,9 @@ ModList* ModList::create(ModListSource* src, CCSize const& size) {
     return nullptr;
 }
 
-void GeodeModListPage::addModSource(ModListSource&& source) {
+void GeodeModListPage::addModSource(ModSource&& source) {
     m_mods.push_back(std::move(source));
+}
+std::vector<ModSource> const& GeodeModListPage::getMods() const {
+    return m_mods;
 }
\ No newline at end of file
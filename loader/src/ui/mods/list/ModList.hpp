@@ -19,11 +19,14 @@ struct ModListProgressStatus {
 };
 using ModListStatus = std::variant<ModListErrorStatus, ModListUnkProgressStatus, ModListProgressStatus>;
 
+class GeodeModListPage;
+
 class ModList : public CCNode {
 protected:
     ModListSource* m_source;
     size_t m_page = 0;
-    ScrollLayer* m_list;
+    std::shared_ptr<GeodeModListPage> m_pageContents;
+    RecyclingScrollLayer* m_list;
     CCMenu* m_statusContainer;
     CCLabelBMFont* m_statusTitle;
     SimpleTextArea* m_statusDetails;
@@ -58,6 +61,7 @@ protected:
 
     bool init(ModListSource* src, CCSize const& size);
 
+    void clearList();
     void updateTopContainer();
     void onCheckUpdates(typename server::ServerRequest<std::vector<std::string>>::Event* event);
     void onInvalidateCache(InvalidateCacheEvent* event);
@@ -95,4 +99,5 @@ protected:
     
 public:
     void addModSource(ModSource&& source) override;
+    std::vector<ModSource> const& getMods() const;
 };
\ No newline at end of file
@@ -294,6 +294,10 @@ std::string ModProblemItem::createProblemMessage() {
             ss << "requires the " << m_problem.message << " mod to be installed.";
             return ss.str();
         }
+        case LoadProblem::Type::DependencyCycle: {
+            ss << "has a circular dependency: " << m_problem.message << ".";
+            return ss.str();
+        }
         default:
             ss << "default case oops";
             return ss.str();
@@ -109,3 +109,175 @@ ScrollLayer* ScrollLayer::create(CCRect const& rect, bool scroll, bool vertical)
 ScrollLayer* ScrollLayer::create(CCSize const& size, bool scroll, bool vertical) {
     return ScrollLayer::create({ 0, 0, size.width, size.height }, scroll, vertical);
 }
+
+RecyclingScrollLayer::RecyclingScrollLayer(
+    CCRect const& rect, bool scrollWheelEnabled, CreateCell&& createCell, BindCell&& bindCell
+) : ScrollLayer(rect, scrollWheelEnabled, true),
+    m_createCell(std::move(createCell)),
+    m_bindCell(std::move(bindCell))
+{
+    this->setID("RecyclingScrollLayer");
+}
+
+size_t RecyclingScrollLayer::getRowCount() const {
+    return (m_itemCount + m_columns - 1) / m_columns;
+}
+
+void RecyclingScrollLayer::positionCell(CCNode* cell, size_t index) {
+    // Cells are laid out top to bottom, left to right
+    auto row = index / m_columns;
+    auto col = index % m_columns;
+    auto anchor = cell->isIgnoreAnchorPointForPosition() ? CCPoint{ 0, 0 } : cell->getAnchorPoint();
+    cell->setPosition(
+        col * (m_cellSize.width + m_gap) + anchor.x * cell->getScaledContentWidth(),
+        m_contentLayer->getContentHeight() - row * (m_cellSize.height + m_gap)
+            - (1.f - anchor.y) * cell->getScaledContentHeight()
+    );
+}
+
+void RecyclingScrollLayer::updateContentHeight() {
+    auto rows = this->getRowCount();
+    auto height = rows ? rows * (m_cellSize.height + m_gap) - m_gap : 0.f;
+    // Make sure the list isn't smaller than the scroll area, so it starts at the top
+    m_contentLayer->setContentSize({ m_obContentSize.width, std::max(height, m_obContentSize.height) });
+    m_positionsDirty = true;
+}
+
+void RecyclingScrollLayer::updateCells(bool rebind) {
+    auto rowHeight = m_cellSize.height + m_gap;
+
+    size_t first = 0;
+    size_t last = 0;
+    if (m_itemCount > 0 && rowHeight > 0) {
+        // How far down from the top of the list the visible area starts
+        auto scrolled = std::max(
+            m_contentLayer->getContentHeight() + m_contentLayer->getPositionY() - m_obContentSize.height, 0.f
+        );
+        auto firstRow = static_cast<size_t>(scrolled / rowHeight);
+        auto lastRow = static_cast<size_t>((scrolled + m_obContentSize.height) / rowHeight) + 1;
+        firstRow = firstRow > m_overscan ? firstRow - m_overscan : 0;
+        lastRow = std::min(lastRow + m_overscan, this->getRowCount());
+        first = std::min(firstRow * m_columns, m_itemCount);
+        last = std::min(lastRow * m_columns, m_itemCount);
+    }
+
+    if (!rebind && !m_positionsDirty && m_cellRange == std::make_pair(first, last)) {
+        return;
+    }
+    m_cellRange = { first, last };
+
+    // Free up the cells of items that are no longer in range
+    for (auto it = m_activeCells.begin(); it != m_activeCells.end();) {
+        if (rebind || it->first < first || it->first >= last) {
+            it->second->removeFromParentAndCleanup(false);
+            m_unusedCells.push_back(std::move(it->second));
+            it = m_activeCells.erase(it);
+        }
+        else {
+            if (m_positionsDirty) {
+                this->positionCell(it->second, it->first);
+            }
+            ++it;
+        }
+    }
+    m_positionsDirty = false;
+
+    // Give every item in range a cell, reusing freed cells where possible
+    for (auto i = first; i < last; i += 1) {
+        if (m_activeCells.contains(i)) {
+            continue;
+        }
+        Ref<CCNode> cell;
+        if (m_unusedCells.size()) {
+            cell = std::move(m_unusedCells.back());
+            m_unusedCells.pop_back();
+            m_bindCell(cell, i);
+        }
+        else {
+            cell = m_createCell(i);
+        }
+        this->positionCell(cell, i);
+        m_contentLayer->addChild(cell);
+        m_activeCells.emplace(i, std::move(cell));
+    }
+}
+
+void RecyclingScrollLayer::removeAllCells() {
+    for (auto& [_, cell] : m_activeCells) {
+        cell->removeFromParentAndCleanup(false);
+    }
+    m_activeCells.clear();
+    m_unusedCells.clear();
+    m_cellRange = { 0, 0 };
+}
+
+void RecyclingScrollLayer::visit() {
+    // Catches every way the list can be scrolled (dragging, momentum, wheel, 
+    // setting the position directly) right before anything is drawn
+    this->updateCells(false);
+    ScrollLayer::visit();
+}
+
+void RecyclingScrollLayer::setContentSize(CCSize const& size) {
+    ScrollLayer::setContentSize(size);
+    // The content layer is created in ScrollLayer's constructor, after the 
+    // initial size has been set
+    if (m_contentLayer) {
+        this->updateContentHeight();
+    }
+}
+
+void RecyclingScrollLayer::setCellSize(CCSize const& size, size_t columns, float gap) {
+    columns = std::max<size_t>(columns, 1);
+    if (m_cellSize.equals(size) && m_columns == columns && m_gap == gap) {
+        return;
+    }
+    m_cellSize = size;
+    m_columns = columns;
+    m_gap = gap;
+
+    // Existing cells may have been laid out for the old size
+    this->removeAllCells();
+    this->updateContentHeight();
+    this->updateCells(true);
+}
+
+void RecyclingScrollLayer::setOverscan(size_t rows) {
+    m_overscan = rows;
+}
+
+void RecyclingScrollLayer::reloadData(size_t itemCount) {
+    m_itemCount = itemCount;
+    this->updateContentHeight();
+    this->updateCells(true);
+}
+
+size_t RecyclingScrollLayer::getItemCount() const {
+    return m_itemCount;
+}
+
+CCNode* RecyclingScrollLayer::getCell(size_t index) const {
+    if (auto it = m_activeCells.find(index); it != m_activeCells.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+std::vector<CCNode*> RecyclingScrollLayer::getActiveCells() const {
+    std::vector<CCNode*> cells;
+    cells.reserve(m_activeCells.size());
+    for (auto& [_, cell] : m_activeCells) {
+        cells.push_back(cell);
+    }
+    return cells;
+}
+
+RecyclingScrollLayer* RecyclingScrollLayer::create(
+    CCSize const& size, CreateCell createCell, BindCell bindCell, bool scrollWheelEnabled
+) {
+    auto ret = new RecyclingScrollLayer(
+        { 0, 0, size.width, size.height }, scrollWheelEnabled, std::move(createCell), std::move(bindCell)
+    );
+    ret->autorelease();
+    return ret;
+}
@@ -4,6 +4,7 @@
 #include <Geode/loader/Dispatch.hpp>
 #include <Geode/Bindings.hpp>
 #include "main.hpp"
+#include <chrono>
 
 using namespace geode::prelude;
 
@@ -196,6 +197,34 @@ struct BeforeMenuLayer : Modify<BeforeMenuLayer, MenuLayer> {
 $on_mod(Loaded) {
     // Mod::get()->addCustomSetting<MySettingValue>("overcast-skies", DEFAULT_ICON);
 
+    // Setting handles
+    {
+        constexpr size_t READS = 1'000'000;
+        size_t trueCount = 0;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < READS; i++) {
+            trueCount += Mod::get()->getSettingValue<bool>("its-raining-after-all");
+        }
+        auto lookupTime = std::chrono::steady_clock::now() - begin;
+
+        auto handle = Mod::get()->getSettingHandle<bool>("its-raining-after-all");
+        begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < READS; i++) {
+            trueCount -= handle.get();
+        }
+        auto handleTime = std::chrono::steady_clock::now() - begin;
+
+        if (trueCount != 0) {
+            log::error("Setting handle read a different value than getSettingValue");
+        }
+        log::info(
+            "{} setting reads: getSettingValue took {}us, SettingHandle took {}us", READS,
+            std::chrono::duration_cast<std::chrono::microseconds>(lookupTime).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(handleTime).count()
+        );
+    }
+
     (void)new EventListener(+[](GJGarageLayer* gl) {
         auto label = CCLabelBMFont::create("Dispatcher works!", "bigFont.fnt");
     	label->setPosition(100, 80);
@@ -60,6 +60,364 @@ $execute {
     }
 }
 
+// Worker-side Task mapping
+$execute {
+    auto mainThread = std::this_thread::get_id();
+    Task<std::string>::immediate(R"({"mods": [1, 2, 3]})").mapOn(
+        TaskExecutor::Worker,
+        [mainThread](std::string* raw) {
+            if (std::this_thread::get_id() == mainThread) {
+                log::error("mapOn(Worker) ran the mapper on the main thread");
+            }
+            return matjson::parse(*raw).unwrapOr(matjson::Value())["mods"].size();
+        }
+    ).listen([mainThread](size_t* count) {
+        if (std::this_thread::get_id() != mainThread) {
+            log::error("mapOn(Worker) delivered the result off the main thread");
+        }
+        log::info("Parsed {} mods off the main thread", *count);
+    });
+}
+
+// Task::map chain latency
+$execute {
+    // Mimics WebRequest -> server::getMods -> ModListSource::loadPage -> ModList
+    auto [request, finish, progress, cancelled] = Task<int>::spawn("Fake request");
+    auto completedFrame = std::make_shared<std::atomic_uint>(0);
+    new EventListener<Task<int>>(
+        [completedFrame](Task<int>::Event* event) {
+            if (event->getValue()) {
+                completedFrame->store(CCDirector::get()->getTotalFrames());
+            }
+        },
+        request
+    );
+    request
+        .map([](int* v) { return *v + 1; })
+        .map([](int* v) { return *v * 2; })
+        .map([](int* v) { return std::to_string(*v); })
+        .listen([completedFrame](std::string* value) {
+            auto frames = CCDirector::get()->getTotalFrames() - completedFrame->load();
+            if (frames != 0) {
+                log::error("Mapped Task chain took {} frames to deliver '{}'", frames, *value);
+            }
+            else {
+                log::info("Mapped Task chain delivered '{}' in the same frame", *value);
+            }
+        });
+    std::thread([finish = finish] {
+        finish(20);
+    }).detach();
+}
+
+// IPC round-trip latency, throughput and attachments, run with --geode:ipc-benchmark
+#if defined(GEODE_IS_ANDROID) || defined(GEODE_IS_MACOS)
+#include <Geode/loader/event/IPC.hpp>
+#include <cstddef>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+$execute {
+    if (!Loader::get()->getLaunchFlag("ipc-benchmark")) return;
+
+    ipc::listen("attachment-echo", [](ipc::IPCEvent* event) -> matjson::Value {
+        auto attachment = event->getAttachment();
+        auto reply = event->writeReplyAttachment(attachment.size());
+        // the span is empty if the reply attachment couldn't be allocated
+        if (reply.size() < attachment.size()) {
+            log::warn("Unable to write a {} byte reply attachment", attachment.size());
+            return matjson::Value();
+        }
+        std::copy(attachment.begin(), attachment.end(), reply.begin());
+        return attachment.size();
+    });
+
+    std::thread([] {
+        auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+    #ifdef GEODE_IS_ANDROID
+        std::strncpy(address.sun_path + 1, ipc::IPC_SOCKET_NAME, sizeof(address.sun_path) - 2);
+        auto addressSize = offsetof(sockaddr_un, sun_path) + 1 + std::strlen(ipc::IPC_SOCKET_NAME);
+    #else
+        std::strncpy(address.sun_path, ipc::IPC_SOCKET_PATH, sizeof(address.sun_path) - 1);
+        auto addressSize = sizeof(address);
+    #endif
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), addressSize) != 0) {
+            log::error("Unable to connect to the IPC socket");
+            close(fd);
+            return;
+        }
+
+        auto const sendRequests = [fd](size_t first, size_t count) {
+            std::string frames;
+            for (size_t id = first; id < first + count; id++) {
+                auto json = matjson::makeObject({
+                    { "id", id },
+                    { "mod", "geode.loader" },
+                    { "message", "ipc-test" },
+                }).dump(matjson::NO_INDENTATION);
+                uint32_t size = json.size();
+                frames.append(reinterpret_cast<char const*>(&size), sizeof(size));
+                frames += json;
+            }
+            for (size_t sent = 0; sent < frames.size();) {
+                auto count = send(fd, frames.data() + sent, frames.size() - sent, 0);
+                if (count <= 0) return false;
+                sent += count;
+            }
+            return true;
+        };
+        auto const readReply = [fd]() -> std::optional<matjson::Value> {
+            auto const readExact = [fd](char* data, size_t size) {
+                for (size_t read = 0; read < size;) {
+                    auto count = recv(fd, data + read, size - read, 0);
+                    if (count <= 0) return false;
+                    read += count;
+                }
+                return true;
+            };
+            uint32_t size;
+            if (!readExact(reinterpret_cast<char*>(&size), sizeof(size))) return std::nullopt;
+            std::string json(size, '\0');
+            if (!readExact(json.data(), size)) return std::nullopt;
+            auto res = matjson::parse(json);
+            if (!res) return std::nullopt;
+            return res.unwrap();
+        };
+
+        // every reply waits for the main thread, so this is roughly a frame
+        constexpr size_t ROUND_TRIPS = 100;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ROUND_TRIPS; i++) {
+            if (!sendRequests(i, 1) || !readReply()) {
+                log::error("IPC round trip {} failed", i);
+                close(fd);
+                return;
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        log::info(
+            "IPC round trip latency: {}us",
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / ROUND_TRIPS
+        );
+
+        // pipelined requests are handled and replied to in batches
+        constexpr size_t PIPELINED = 10000;
+        start = std::chrono::steady_clock::now();
+        if (!sendRequests(ROUND_TRIPS, PIPELINED)) {
+            log::error("Unable to send pipelined IPC requests");
+            close(fd);
+            return;
+        }
+        size_t replies = 0;
+        while (replies < PIPELINED) {
+            auto reply = readReply();
+            if (!reply || !reply->contains("id")) break;
+            replies += 1;
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        auto seconds = std::chrono::duration<double>(elapsed).count();
+        log::info(
+            "IPC pipelined throughput: {} of {} replies in {:.3f}s ({:.0f} messages/s)",
+            replies, PIPELINED, seconds, replies / seconds
+        );
+
+        // attachments skip JSON entirely, and are echoed back the same way
+        constexpr size_t ATTACHMENT_SIZE = 4 * 1024 * 1024;
+        constexpr size_t ATTACHMENT_ROUND_TRIPS = 20;
+        std::string attachment(ATTACHMENT_SIZE, '\0');
+        for (size_t i = 0; i < attachment.size(); i++) {
+            attachment[i] = static_cast<char>(i * 31);
+        }
+        auto json = matjson::makeObject({
+            { "mod", "geode.test" },
+            { "message", "attachment-echo" },
+        }).dump(matjson::NO_INDENTATION);
+        uint32_t header = (sizeof(uint32_t) + attachment.size() + json.size()) | 0x80000000;
+        uint32_t attachmentSize = attachment.size();
+        std::string frame;
+        frame.append(reinterpret_cast<char const*>(&header), sizeof(header));
+        frame.append(reinterpret_cast<char const*>(&attachmentSize), sizeof(attachmentSize));
+        frame += attachment;
+        frame += json;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ATTACHMENT_ROUND_TRIPS; i++) {
+            std::string reply;
+            bool ok = send(fd, frame.data(), frame.size(), 0) == static_cast<ssize_t>(frame.size());
+            ok = ok && recv(fd, &header, sizeof(header), MSG_WAITALL) == sizeof(header);
+            if (ok) {
+                reply.resize(header & ~0x80000000);
+                ok = recv(fd, reply.data(), reply.size(), MSG_WAITALL) == static_cast<ssize_t>(reply.size());
+            }
+            if (!ok || reply.compare(sizeof(uint32_t), attachment.size(), attachment) != 0) {
+                log::error("IPC attachment round trip {} failed", i);
+                close(fd);
+                return;
+            }
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        seconds = std::chrono::duration<double>(elapsed).count();
+        log::info(
+            "IPC attachment round trips: {} x {} bytes in {:.3f}s ({:.0f} MB/s each way)",
+            ATTACHMENT_ROUND_TRIPS, ATTACHMENT_SIZE, seconds,
+            ATTACHMENT_SIZE * ATTACHMENT_ROUND_TRIPS / seconds / 1e6
+        );
+        close(fd);
+    }).detach();
+}
+#endif
+
+// SHA-256 throughput across buffer sizes, run with --geode:sha256-benchmark
+#include <Geode/utils/hash.hpp>
+
+$execute {
+    if (!Loader::get()->getLaunchFlag("sha256-benchmark")) return;
+
+    std::thread([] {
+        utils::SHA256Hasher hasher;
+        hasher.update("abc");
+        auto expected = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+        if (auto hex = hasher.finishHex(); hex != expected) {
+            log::error("SHA-256 of \"abc\" was {}, expected {}", hex, expected);
+            return;
+        }
+
+        // the same amount of data is hashed for every size, so the small 
+        // buffers show the per-hash overhead
+        constexpr size_t TOTAL_SIZE = 256 * 1024 * 1024;
+        std::vector<uint8_t> data(16 * 1024 * 1024);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<uint8_t>(i * 31);
+        }
+        for (size_t size : { 64, 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 }) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t hashed = 0; hashed < TOTAL_SIZE; hashed += size) {
+                hasher.update(std::span(data.data(), size));
+                hasher.finish();
+            }
+            auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            log::info("SHA-256 of {} byte buffers: {:.0f} MB/s", size, TOTAL_SIZE / seconds / 1e6);
+        }
+    }).detach();
+}
+
+// File watching through the shared inotify thread
+#ifdef GEODE_IS_ANDROID
+#include <Geode/utils/file.hpp>
+#include <future>
+
+$execute {
+    auto dir = Mod::get()->getSaveDir() / "file-watch-test";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+    if (auto res = file::watchFile(dir); !res) {
+        log::error("Unable to watch {}: {}", dir, res.unwrapErr());
+        return;
+    }
+
+    // only touched on the main thread, where watch events are posted
+    auto dirChanges = std::make_shared<size_t>(0);
+    auto fileChanges = std::make_shared<size_t>(0);
+    new EventListener<FileWatchFilter>([dirChanges](FileWatchEvent*) {
+        *dirChanges += 1;
+    }, FileWatchFilter(dir));
+
+    std::thread([dir, dirChanges, fileChanges] {
+        // changes are reported once the file has been quiet for a while
+        auto const settle = [] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        };
+        auto const onMainThread = [](std::function<void()> func) {
+            std::promise<void> done;
+            queueInMainThread([&] {
+                func();
+                done.set_value();
+            });
+            done.get_future().wait();
+        };
+        auto path = dir / "watched.txt";
+
+        (void)file::writeString(path, "created");
+        settle();
+        onMainThread([&] {
+            if (*dirChanges == 0) {
+                log::error("Creating a file wasn't reported for its directory");
+            }
+            if (auto res = file::watchFile(path); !res) {
+                log::error("Unable to watch {}: {}", path, res.unwrapErr());
+            }
+            new EventListener<FileWatchFilter>([fileChanges](FileWatchEvent*) {
+                *fileChanges += 1;
+            }, FileWatchFilter(path));
+        });
+
+        (void)file::writeString(path, "modified");
+        settle();
+        size_t afterModify = 0;
+        onMainThread([&] {
+            afterModify = *fileChanges;
+            if (afterModify == 0) {
+                log::error("Modifying a watched file wasn't reported");
+            }
+        });
+
+        // editors commonly save by writing a new file and renaming it over
+        (void)file::writeString(dir / "watched.txt.tmp", "replaced");
+        std::filesystem::rename(dir / "watched.txt.tmp", path, ec);
+        settle();
+        onMainThread([&] {
+            if (*fileChanges == afterModify) {
+                log::error("Renaming a file over a watched file wasn't reported");
+            }
+            else {
+                log::info("File watching reported creating, modifying and replacing a file");
+            }
+            file::unwatchFile(path);
+            file::unwatchFile(dir);
+        });
+        std::filesystem::remove_all(dir, ec);
+    }).detach();
+}
+#endif
+
+// AxisLayout result cache
+#include <Geode/ui/SpacerNode.hpp>
+
+$execute {
+    auto container = CCNode::create();
+    container->setContentSize({ 100, 20 });
+    auto spacer = SpacerNode::create(1);
+    auto middle = CCNode::create();
+    for (auto node : { CCNode::create(), static_cast<CCNode*>(spacer), middle, static_cast<CCNode*>(SpacerNode::create(1)), CCNode::create() }) {
+        if (!typeinfo_cast<SpacerNode*>(node)) {
+            node->setContentSize({ 10, 10 });
+        }
+        container->addChild(node);
+    }
+    container->setLayout(RowLayout::create()->setGap(0));
+
+    // nothing changed, so this restores the cached positions
+    auto first = middle->getPositionX();
+    container->updateLayout();
+    if (middle->getPositionX() != first) {
+        log::error("AxisLayout moved a node without any of its inputs changing");
+    }
+
+    spacer->setGrow(3);
+    container->updateLayout();
+    if (middle->getPositionX() == first) {
+        log::error("AxisLayout reused its cached result after a spacer's grow changed");
+    }
+    else {
+        log::info("AxisLayout recomputed after a spacer's grow changed");
+    }
+}
+
 #include <Geode/modify/MenuLayer.hpp>
 struct $modify(MenuLayer) {
     bool init() {